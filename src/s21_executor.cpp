@@ -0,0 +1,178 @@
+#include "s21_executor.hpp"
+
+#include "s21_numa.hpp"
+#include "s21_parallel.hpp"
+
+namespace s21 {
+
+CancelToken::CancelToken() : flag_(std::make_shared<std::atomic<bool>>(false)) {
+}
+
+void CancelToken::Cancel() noexcept {
+    flag_->store(true);
+}
+
+bool CancelToken::IsCancelled() const noexcept {
+    return flag_->load();
+}
+
+Executor::Executor(int32_t workers) : own_(workers), stop_(false) {
+    threads_.reserve(workers);
+    for (int32_t i = 0; i < workers; ++i)
+        threads_.emplace_back(&Executor::Run, this, i);
+}
+
+Executor::~Executor() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    ready_.notify_all();
+    for (auto &thread : threads_)
+        thread.join();
+}
+
+Executor &Executor::Instance() {
+    // The threads calling parallel_for take part in the work themselves,
+    // so one worker fewer than the hardware threads keeps the machine
+    // fully but not over subscribed.
+    static Executor executor(std::max(1, concurrency() - 1));
+    return executor;
+}
+
+int32_t Executor::get_workers() const noexcept {
+    return static_cast<int32_t>(threads_.size());
+}
+
+void Executor::Submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push_back(std::move(task));
+    }
+    ready_.notify_one();
+}
+
+void Executor::SubmitTo(int32_t worker, std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        own_[worker % own_.size()].push_back(std::move(task));
+    }
+    // Any waiting worker may be woken, so all of them are.
+    ready_.notify_all();
+}
+
+void Executor::Run(int32_t worker) {
+    pin_worker(worker);
+    std::deque<std::function<void()>> &own = own_[worker];
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            ready_.wait(lock, [&] {
+                return stop_ || !own.empty() || !queue_.empty();
+            });
+            std::deque<std::function<void()>> &source =
+                own.empty() ? queue_ : own;
+            if (source.empty())
+                return;
+            task = std::move(source.front());
+            source.pop_front();
+        }
+        task();
+    }
+}
+
+TaskGraph::Node TaskGraph::Add(std::function<void()> work,
+                               const std::vector<Node> &deps) {
+    const Node node = tasks_.size();
+    for (Node dep : deps)
+        if (dep >= node)
+            throw std::logic_error("A dependency has to be added before use");
+
+    tasks_.push_back({std::move(work), {}, deps.size()});
+    for (Node dep : deps)
+        tasks_[dep].successors.push_back(node);
+
+    return node;
+}
+
+namespace {
+
+struct GraphRun {
+    std::vector<std::function<void()>> work;
+    std::vector<std::vector<TaskGraph::Node>> successors;
+    std::unique_ptr<std::atomic<size_t>[]> pending;
+    std::atomic<size_t> remaining;
+    std::atomic<bool> failed{false};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    std::promise<void> done;
+    CancelToken token;
+
+    void fail(std::exception_ptr e) {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (!error)
+            error = e;
+        failed = true;
+    }
+};
+
+void run_node(const std::shared_ptr<GraphRun> &run, TaskGraph::Node node) {
+    if (!run->failed && run->token.IsCancelled())
+        run->fail(std::make_exception_ptr(OperationCancelled()));
+
+    if (!run->failed) {
+        try {
+            run->work[node]();
+        } catch (...) {
+            run->fail(std::current_exception());
+        }
+    }
+    run->work[node] = nullptr;
+
+    for (TaskGraph::Node next : run->successors[node])
+        if (--run->pending[next] == 0)
+            Executor::Instance().Submit([run, next] { run_node(run, next); });
+
+    if (--run->remaining == 0) {
+        if (run->error)
+            run->done.set_exception(run->error);
+        else
+            run->done.set_value();
+    }
+}
+
+}  // namespace
+
+std::future<void> TaskGraph::Launch(CancelToken token) {
+    auto run = std::make_shared<GraphRun>();
+    const size_t size = tasks_.size();
+    run->pending.reset(new std::atomic<size_t>[size]);
+    run->remaining = size;
+    run->token = token;
+    for (size_t i = 0; i < size; ++i) {
+        run->work.push_back(std::move(tasks_[i].work));
+        run->successors.push_back(std::move(tasks_[i].successors));
+        run->pending[i] = tasks_[i].dependencies;
+    }
+    tasks_.clear();
+
+    std::future<void> future = run->done.get_future();
+    if (size == 0) {
+        run->done.set_value();
+        return future;
+    }
+
+    // Roots are collected up front, a finished root may already be
+    // releasing its successors while they are being submitted.
+    std::vector<Node> roots;
+    for (size_t i = 0; i < size; ++i)
+        if (run->pending[i] == 0)
+            roots.push_back(i);
+    for (Node root : roots)
+        Executor::Instance().Submit([run, root] { run_node(run, root); });
+
+    return future;
+}
+
+}  // namespace s21
@@ -0,0 +1,121 @@
+#ifndef SRC_S21_EXECUTOR_H_
+#define SRC_S21_EXECUTOR_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace s21 {
+
+class OperationCancelled : public std::runtime_error {
+  public:
+    OperationCancelled() : std::runtime_error("The operation was cancelled") {
+    }
+};
+
+// Copies share one flag, so a token handed to several operations cancels
+// all of them. Work that has already started runs to completion.
+class CancelToken {
+  private:
+    std::shared_ptr<std::atomic<bool>> flag_;
+
+  public:
+    CancelToken();
+
+    void Cancel() noexcept;
+    bool IsCancelled() const noexcept;
+};
+
+// Process-wide fixed-size worker pool. Kernels split through parallel_for
+// and asynchronous operations share it, so nesting them never creates more
+// threads than the machine has.
+class Executor {
+  private:
+    std::vector<std::thread> threads_;
+    std::deque<std::function<void()>> queue_;
+    std::vector<std::deque<std::function<void()>>> own_;
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    bool stop_;
+
+    explicit Executor(int32_t workers);
+    void Run(int32_t worker);
+
+  public:
+    Executor(const Executor &) = delete;
+    Executor &operator=(const Executor &) = delete;
+    ~Executor();
+
+    static Executor &Instance();
+
+    int32_t get_workers() const noexcept;
+    void Submit(std::function<void()> task);
+    // Queues task for one worker, modulo the pool size. The worker runs its
+    // own tasks before shared ones.
+    void SubmitTo(int32_t worker, std::function<void()> task);
+};
+
+template <class F>
+auto Async(F work, CancelToken token = CancelToken())
+    -> std::future<decltype(work())> {
+    using Result = decltype(work());
+
+    auto promise = std::make_shared<std::promise<Result>>();
+    std::future<Result> future = promise->get_future();
+    Executor::Instance().Submit(
+        [promise, token, work = std::move(work)]() mutable {
+            try {
+                if (token.IsCancelled())
+                    throw OperationCancelled();
+                if constexpr (std::is_void_v<Result>) {
+                    work();
+                    promise->set_value();
+                } else {
+                    promise->set_value(work());
+                }
+            } catch (...) {
+                promise->set_exception(std::current_exception());
+            }
+        });
+
+    return future;
+}
+
+// Dependency graph of operations. A node is handed to the executor as soon
+// as all of its dependencies have finished, so independent branches run
+// concurrently. Dependencies have to be added first, which keeps the graph
+// acyclic.
+class TaskGraph {
+  public:
+    using Node = size_t;
+
+  private:
+    struct Task {
+        std::function<void()> work;
+        std::vector<Node> successors;
+        size_t dependencies;
+    };
+
+    std::vector<Task> tasks_;
+
+  public:
+    Node Add(std::function<void()> work, const std::vector<Node> &deps = {});
+
+    // Runs the graph and resolves once every node has finished. After a
+    // failure or a cancellation the remaining nodes are skipped and the
+    // future rethrows the first error. The graph is consumed.
+    std::future<void> Launch(CancelToken token = CancelToken());
+};
+
+}  // namespace s21
+
+#endif  // SRC_S21_EXECUTOR_H_
@@ -0,0 +1,260 @@
+#include "s21_kernels.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "s21_parallel.hpp"
+#include "s21_trace.hpp"
+#include "s21_tuning.hpp"
+
+namespace s21 {
+namespace kernel {
+
+namespace {
+
+void scale(int32_t m, int32_t n, double beta, double *c, ptrdiff_t ldc) {
+    if (beta == 1.0)
+        return;
+
+    for (int32_t i = 0; i < m; ++i) {
+        double *row = c + i * ldc;
+        if (beta == 0.0)
+            std::fill(row, row + n, 0.0);
+        else
+            for (int32_t j = 0; j < n; ++j)
+                row[j] *= beta;
+    }
+}
+
+void pack(View src, int32_t row0, int32_t rows, int32_t col0, int32_t cols,
+          double *dst) {
+    S21_TRACE_SCOPE("gemm.pack", rows, cols);
+    if (src.col_stride == 1) {
+        for (int32_t i = 0; i < rows; ++i) {
+            const double *row = src.data + (row0 + i) * src.row_stride + col0;
+            std::copy(row, row + cols, dst + i * cols);
+        }
+    } else {
+        for (int32_t i = 0; i < rows; ++i)
+            for (int32_t j = 0; j < cols; ++j)
+                dst[i * cols + j] = src.at(row0 + i, col0 + j);
+    }
+}
+
+// c[mb x nb] (+)= a[mb x kb] * b[kb x nb], both operands packed
+// contiguously. With overwrite set c is written without being read.
+void block(int32_t mb, int32_t nb, int32_t kb, const double *a,
+           const double *b, double *c, ptrdiff_t ldc, bool overwrite) {
+    S21_TRACE_SCOPE("gemm.compute", mb, nb);
+    for (int32_t i = 0; i < mb; ++i) {
+        double *crow = c + i * ldc;
+        const double *arow = a + i * kb;
+        int32_t p = 0;
+        if (overwrite) {
+            for (int32_t j = 0; j < nb; ++j)
+                crow[j] = arow[0] * b[j];
+            p = 1;
+        }
+        for (; p < kb; ++p) {
+            const double aip = arow[p];
+            const double *brow = b + p * nb;
+            for (int32_t j = 0; j < nb; ++j)
+                crow[j] += aip * brow[j];
+        }
+    }
+}
+
+}  // namespace
+
+void gemm(int32_t m, int32_t n, int32_t k, double alpha, View a, View b,
+          double beta, double *c, ptrdiff_t ldc) {
+    if (alpha == 0.0 || k == 0) {
+        scale(m, n, beta, c, ldc);
+        return;
+    }
+
+    // beta == 0 is folded into the first pass over k, which overwrites c.
+    const bool overwrite = beta == 0.0;
+    if (!overwrite)
+        scale(m, n, beta, c, ldc);
+
+    const TuningParams &params = tuning();
+    const int32_t block_m = params.gemm_block_m;
+    const int32_t block_k = params.gemm_block_k;
+    const int32_t block_n = params.gemm_block_n;
+
+    // Threads share out whole column panels, each element of c is still
+    // summed over k in the same order whatever the thread count or the
+    // block sizes.
+    const int64_t panels = (n + block_n - 1) / block_n;
+    const int64_t panel_flops = static_cast<int64_t>(m) * k * block_n;
+    parallel_for(panels,
+                 std::max<int64_t>(1, params.parallel_cutoff * 64 / panel_flops),
+                 [&](int64_t first, int64_t last) {
+        thread_local std::vector<double> a_pack;
+        thread_local std::vector<double> b_pack;
+        a_pack.resize(static_cast<size_t>(block_m) * block_k);
+        b_pack.resize(static_cast<size_t>(block_k) * block_n);
+
+        const int32_t j_end = static_cast<int32_t>(
+            std::min<int64_t>(n, last * block_n));
+        for (int32_t j0 = static_cast<int32_t>(first * block_n); j0 < j_end;
+             j0 += block_n) {
+            const int32_t nb = std::min(block_n, n - j0);
+            for (int32_t p0 = 0; p0 < k; p0 += block_k) {
+                const int32_t kb = std::min(block_k, k - p0);
+                pack(b, p0, kb, j0, nb, b_pack.data());
+
+                for (int32_t i0 = 0; i0 < m; i0 += block_m) {
+                    const int32_t mb = std::min(block_m, m - i0);
+                    pack(a, i0, mb, p0, kb, a_pack.data());
+                    if (alpha != 1.0)
+                        for (int32_t t = 0; t < mb * kb; ++t)
+                            a_pack[t] *= alpha;
+
+                    block(mb, nb, kb, a_pack.data(), b_pack.data(),
+                          c + i0 * ldc + j0, ldc, overwrite && p0 == 0);
+                }
+            }
+        }
+    });
+}
+
+double pairwise_sum(const double *x, int64_t n) {
+    if (n <= 128) {
+        double acc[8] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+        int64_t i = 0;
+        for (; i + 8 <= n; i += 8)
+            for (int32_t l = 0; l < 8; ++l)
+                acc[l] += x[i + l];
+        for (; i < n; ++i)
+            acc[0] += x[i];
+        return ((acc[0] + acc[1]) + (acc[2] + acc[3])) +
+               ((acc[4] + acc[5]) + (acc[6] + acc[7]));
+    }
+
+    const int64_t half = n / 2 / 8 * 8;
+    return pairwise_sum(x, half) + pairwise_sum(x + half, n - half);
+}
+
+double dot(int32_t n, const double *x, const double *y) {
+    double acc[4] = {0.0, 0.0, 0.0, 0.0};
+    int32_t i = 0;
+    for (; i + 4 <= n; i += 4)
+        for (int32_t l = 0; l < 4; ++l)
+            acc[l] += x[i + l] * y[i + l];
+    for (; i < n; ++i)
+        acc[0] += x[i] * y[i];
+
+    return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+}
+
+void axpy(int32_t n, double alpha, const double *x, double *y) {
+    for (int32_t i = 0; i < n; ++i)
+        y[i] += alpha * x[i];
+}
+
+void gemv(int32_t m, int32_t n, double alpha, const double *a, bool trans,
+          const double *x, double beta, double *y) {
+    S21_TRACE_SCOPE("gemv", m, n);
+    // Rows are independent, so they are split between threads.
+    if (!trans && alpha != 0.0) {
+        parallel_for(m, std::max<int64_t>(1, parallel_cutoff() / std::max(n, 1)),
+                     [&](int64_t first, int64_t last) {
+                         for (int64_t i = first; i < last; ++i) {
+                             const double d = alpha * dot(n, a + i * n, x);
+                             y[i] = beta == 0.0 ? d : beta * y[i] + d;
+                         }
+                     });
+        return;
+    }
+
+    const int32_t len = trans ? n : m;
+    scale(1, len, beta, y, len);
+    if (alpha == 0.0)
+        return;
+
+    for (int32_t i = 0; i < m; ++i) {
+        const double *row = a + static_cast<ptrdiff_t>(i) * n;
+        if (trans)
+            axpy(n, alpha * x[i], row, y);
+        else
+            y[i] += alpha * dot(n, row, x);
+    }
+}
+
+void transpose(int32_t rows, int32_t cols, const double *src, double *dst) {
+    S21_TRACE_SCOPE("transpose", rows, cols);
+    const int32_t block = tuning().transpose_block;
+    for (int32_t i0 = 0; i0 < rows; i0 += block) {
+        const int32_t i1 = std::min(rows, i0 + block);
+        for (int32_t j0 = 0; j0 < cols; j0 += block) {
+            const int32_t j1 = std::min(cols, j0 + block);
+            for (int32_t i = i0; i < i1; ++i)
+                for (int32_t j = j0; j < j1; ++j)
+                    dst[static_cast<ptrdiff_t>(j) * rows + i] =
+                        src[static_cast<ptrdiff_t>(i) * cols + j];
+        }
+    }
+}
+
+void ger(int32_t m, int32_t n, double alpha, const double *x, const double *y,
+         double *a) {
+    for (int32_t i = 0; i < m; ++i)
+        axpy(n, alpha * x[i], y, a + static_cast<ptrdiff_t>(i) * n);
+}
+
+int lu(int32_t n, double *a, int32_t *pivots) {
+    S21_TRACE_SCOPE("lu.factor", n, n);
+    int sign = 1;
+    for (int32_t k = 0; k < n; ++k) {
+        int32_t pivot = k;
+        for (int32_t i = k + 1; i < n; ++i)
+            if (std::fabs(a[i * n + k]) > std::fabs(a[pivot * n + k]))
+                pivot = i;
+
+        pivots[k] = pivot;
+        if (pivot != k) {
+            std::swap_ranges(a + k * n, a + (k + 1) * n, a + pivot * n);
+            sign = -sign;
+        }
+
+        const double diag = a[k * n + k];
+        if (diag == 0.0)
+            continue;
+
+        const double *row_k = a + k * n + k + 1;
+        for (int32_t i = k + 1; i < n; ++i) {
+            double *row_i = a + i * n;
+            row_i[k] /= diag;
+            axpy(n - k - 1, -row_i[k], row_k, row_i + k + 1);
+        }
+    }
+    return sign;
+}
+
+void lu_solve(int32_t n, const double *lu, const int32_t *pivots, double *b,
+              int32_t nrhs, ptrdiff_t ldb) {
+    S21_TRACE_SCOPE("lu.solve", n, nrhs);
+    for (int32_t k = 0; k < n; ++k)
+        if (pivots[k] != k)
+            std::swap_ranges(b + k * ldb, b + k * ldb + nrhs,
+                             b + pivots[k] * ldb);
+
+    for (int32_t i = 1; i < n; ++i)
+        for (int32_t j = 0; j < i; ++j)
+            axpy(nrhs, -lu[i * n + j], b + j * ldb, b + i * ldb);
+
+    for (int32_t i = n - 1; i >= 0; --i) {
+        double *row = b + i * ldb;
+        for (int32_t j = i + 1; j < n; ++j)
+            axpy(nrhs, -lu[i * n + j], b + j * ldb, row);
+        const double diag = lu[i * n + i];
+        for (int32_t c = 0; c < nrhs; ++c)
+            row[c] /= diag;
+    }
+}
+
+}  // namespace kernel
+}  // namespace s21
@@ -0,0 +1,69 @@
+#ifndef SRC_S21_KERNELS_H_
+#define SRC_S21_KERNELS_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace s21 {
+namespace kernel {
+
+// GEMM and transpose blocking comes from TuningParams.
+constexpr int32_t kTriangularBlock = 64;
+
+// Reductions split their input into pieces of this fixed size, never by the
+// thread count, so results don't depend on how many threads took part.
+constexpr int64_t kReduceChunk = 4096;
+
+// Strided view of a row-major operand: element (i, j) lives at
+// data[i * row_stride + j * col_stride], so a transposed operand is the
+// same buffer with the strides swapped.
+struct View {
+    const double *data;
+    ptrdiff_t row_stride;
+    ptrdiff_t col_stride;
+
+    double at(int32_t i, int32_t j) const {
+        return data[i * row_stride + j * col_stride];
+    }
+};
+
+inline View view(const double *data, int32_t cols, bool trans) {
+    return trans ? View{data, 1, cols} : View{data, cols, 1};
+}
+
+// c (m x n, leading dimension ldc) = alpha * a (m x k) * b (k x n) + beta * c
+void gemm(int32_t m, int32_t n, int32_t k, double alpha, View a, View b,
+          double beta, double *c, ptrdiff_t ldc);
+
+// y = alpha * op(a) * x + beta * y, a is a dense row-major m x n buffer
+void gemv(int32_t m, int32_t n, double alpha, const double *a, bool trans,
+          const double *x, double beta, double *y);
+
+// a (m x n) += alpha * x * y^T
+void ger(int32_t m, int32_t n, double alpha, const double *x, const double *y,
+         double *a);
+
+// dst (cols x rows) = src (rows x cols)^T, walked in square tiles so both
+// sides stay in cache.
+void transpose(int32_t rows, int32_t cols, const double *src, double *dst);
+
+// Pairwise summation, the error grows with log(n) instead of n.
+double pairwise_sum(const double *x, int64_t n);
+
+double dot(int32_t n, const double *x, const double *y);
+void axpy(int32_t n, double alpha, const double *x, double *y);
+
+// In-place LU factorization with partial pivoting of a row-major n x n
+// buffer, row i was swapped with pivots[i]. Returns the sign of the row
+// permutation.
+int lu(int32_t n, double *a, int32_t *pivots);
+
+// Overwrites columns [0, nrhs) of b (leading dimension ldb) with the
+// solution of A x = b given the factors from lu().
+void lu_solve(int32_t n, const double *lu, const int32_t *pivots, double *b,
+              int32_t nrhs, ptrdiff_t ldb);
+
+}  // namespace kernel
+}  // namespace s21
+
+#endif  // SRC_S21_KERNELS_H_
@@ -0,0 +1,374 @@
+#include "s21_krylov.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "s21_kernels.hpp"
+#include "s21_trace.hpp"
+
+namespace s21 {
+
+namespace {
+
+using kernel::axpy;
+using kernel::dot;
+
+double norm(int32_t n, const double *x) {
+    return std::sqrt(dot(n, x, x));
+}
+
+void precondition(const Preconditioner *m, int32_t n, const double *r,
+                  double *z) {
+    if (m)
+        m->Apply(r, z);
+    else
+        std::copy(r, r + n, z);
+}
+
+// r = b - A x
+void residual(const LinearOperator &a, int32_t n, const double *b,
+              const double *x, double *r) {
+    a(x, r);
+    for (int32_t i = 0; i < n; ++i)
+        r[i] = b[i] - r[i];
+}
+
+}  // namespace
+
+JacobiPreconditioner::JacobiPreconditioner(const S21Matrix &a)
+    : inverse_diagonal_(a.get_rows()) {
+    if (a.get_rows() != a.get_cols())
+        throw std::logic_error(
+            "The matrix is not square to build a preconditioner");
+
+    for (int32_t i = 0; i < a.get_rows(); ++i) {
+        if (a[i][i] == 0.0)
+            throw std::logic_error(
+                "Jacobi preconditioner needs a nonzero diagonal");
+        inverse_diagonal_[i] = 1.0 / a[i][i];
+    }
+}
+
+void JacobiPreconditioner::Apply(const double *r, double *z) const {
+    for (size_t i = 0; i < inverse_diagonal_.size(); ++i)
+        z[i] = inverse_diagonal_[i] * r[i];
+}
+
+Ilu0Preconditioner::Ilu0Preconditioner(const S21Matrix &a)
+    : size_(a.get_rows()), row_start_(1, 0), diagonal_(size_) {
+    if (a.get_rows() != a.get_cols())
+        throw std::logic_error(
+            "The matrix is not square to build a preconditioner");
+
+    for (int32_t i = 0; i < size_; ++i) {
+        diagonal_[i] = -1;
+        for (int32_t j = 0; j < size_; ++j) {
+            if (a[i][j] == 0.0)
+                continue;
+            if (i == j)
+                diagonal_[i] = static_cast<int64_t>(col_.size());
+            col_.push_back(j);
+            value_.push_back(a[i][j]);
+        }
+        if (diagonal_[i] < 0)
+            throw std::logic_error(
+                "ILU(0) preconditioner needs a nonzero diagonal");
+        row_start_.push_back(static_cast<int64_t>(col_.size()));
+    }
+
+    // Row i is eliminated with the rows above it, fill-in outside the
+    // pattern is dropped. position[j] is where column j sits in row i.
+    std::vector<int64_t> position(size_, -1);
+    for (int32_t i = 0; i < size_; ++i) {
+        for (int64_t p = row_start_[i]; p < row_start_[i + 1]; ++p)
+            position[col_[p]] = p;
+
+        for (int64_t p = row_start_[i]; p < diagonal_[i]; ++p) {
+            const int32_t k = col_[p];
+            value_[p] /= value_[diagonal_[k]];
+            for (int64_t q = diagonal_[k] + 1; q < row_start_[k + 1]; ++q)
+                if (position[col_[q]] >= 0)
+                    value_[position[col_[q]]] -= value_[p] * value_[q];
+        }
+        if (value_[diagonal_[i]] == 0.0)
+            throw std::logic_error("ILU(0) preconditioner hit a zero pivot");
+
+        for (int64_t p = row_start_[i]; p < row_start_[i + 1]; ++p)
+            position[col_[p]] = -1;
+    }
+}
+
+void Ilu0Preconditioner::Apply(const double *r, double *z) const {
+    // L has a unit diagonal, U keeps the pivots.
+    for (int32_t i = 0; i < size_; ++i) {
+        double sum = r[i];
+        for (int64_t p = row_start_[i]; p < diagonal_[i]; ++p)
+            sum -= value_[p] * z[col_[p]];
+        z[i] = sum;
+    }
+    for (int32_t i = size_ - 1; i >= 0; --i) {
+        double sum = z[i];
+        for (int64_t p = diagonal_[i] + 1; p < row_start_[i + 1]; ++p)
+            sum -= value_[p] * z[col_[p]];
+        z[i] = sum / value_[diagonal_[i]];
+    }
+}
+
+KrylovSolver::KrylovSolver(Method method, int32_t size, int32_t restart)
+    : method_(method), size_(size), restart_(restart), tolerance_(1e-10),
+      max_iterations_(1000) {
+    if (size_ <= 0)
+        throw std::length_error("Array size can't be zero");
+    if (restart_ <= 0)
+        throw std::logic_error("GMRES restart length must be positive");
+
+    const size_t n = size_;
+    switch (method_) {
+        case Method::kCg:
+            work_.resize(4 * n);
+            break;
+        case Method::kBiCgStab:
+            work_.resize(8 * n);
+            break;
+        case Method::kGmres:
+            // Basis vectors plus two scratch vectors, the Hessenberg matrix
+            // is followed by the Givens rotations and the projected residual.
+            work_.resize((restart_ + 3) * n);
+            hessenberg_.resize(static_cast<size_t>(restart_ + 1) * restart_ +
+                               3 * static_cast<size_t>(restart_ + 1));
+            break;
+    }
+}
+
+int32_t KrylovSolver::get_size() const noexcept {
+    return size_;
+}
+
+int32_t KrylovSolver::get_restart() const noexcept {
+    return restart_;
+}
+
+double KrylovSolver::get_tolerance() const noexcept {
+    return tolerance_;
+}
+
+int32_t KrylovSolver::get_max_iterations() const noexcept {
+    return max_iterations_;
+}
+
+void KrylovSolver::set_tolerance(double tolerance) {
+    if (!(tolerance > 0.0))
+        throw std::logic_error("Tolerance must be positive");
+    tolerance_ = tolerance;
+}
+
+void KrylovSolver::set_max_iterations(int32_t max_iterations) {
+    if (max_iterations < 0)
+        throw std::logic_error("Iteration limit can't be negative");
+    max_iterations_ = max_iterations;
+}
+
+SolverStats KrylovSolver::Solve(const LinearOperator &a, const S21Matrix &b,
+                                S21Matrix &x, const Preconditioner *m) {
+    S21_TRACE_SCOPE("KrylovSolver::Solve", size_, 1);
+    if (b.get_rows() != size_ || b.get_cols() != 1 || x.get_rows() != size_ ||
+        x.get_cols() != 1)
+        throw std::logic_error("Dimensions don't fit for the solver");
+
+    const double *rhs = b[0];
+    double *solution = x[0];
+    if (norm(size_, rhs) == 0.0) {
+        std::fill(solution, solution + size_, 0.0);
+        return {0, 0.0, true};
+    }
+
+    switch (method_) {
+        case Method::kCg:
+            return Cg(a, rhs, solution, m);
+        case Method::kGmres:
+            return Gmres(a, rhs, solution, m);
+        default:
+            return BiCgStab(a, rhs, solution, m);
+    }
+}
+
+SolverStats KrylovSolver::Solve(const S21Matrix &a, const S21Matrix &b,
+                                S21Matrix &x, const Preconditioner *m) {
+    if (a.get_rows() != size_ || a.get_cols() != size_)
+        throw std::logic_error("Dimensions don't fit for the solver");
+
+    const double *data = a[0];
+    const int32_t n = size_;
+    auto product = [data, n](const double *in, double *out) {
+        kernel::gemv(n, n, 1.0, data, false, in, 0.0, out);
+    };
+    return Solve(product, b, x, m);
+}
+
+SolverStats KrylovSolver::Cg(const LinearOperator &a, const double *b,
+                             double *x, const Preconditioner *m) {
+    const int32_t n = size_;
+    double *r = work_.data(), *z = r + n, *p = z + n, *q = p + n;
+    const double b_norm = norm(n, b);
+
+    residual(a, n, b, x, r);
+    double res = norm(n, r) / b_norm;
+    precondition(m, n, r, z);
+    std::copy(z, z + n, p);
+    double rz = dot(n, r, z);
+
+    int32_t it = 0;
+    for (; it < max_iterations_ && res > tolerance_; ++it) {
+        a(p, q);
+        const double pq = dot(n, p, q);
+        if (!(pq > 0.0))
+            break;
+
+        const double alpha = rz / pq;
+        axpy(n, alpha, p, x);
+        axpy(n, -alpha, q, r);
+        res = norm(n, r) / b_norm;
+
+        precondition(m, n, r, z);
+        const double rz_next = dot(n, r, z);
+        const double beta = rz_next / rz;
+        rz = rz_next;
+        for (int32_t i = 0; i < n; ++i)
+            p[i] = z[i] + beta * p[i];
+    }
+
+    return {it, res, res <= tolerance_};
+}
+
+SolverStats KrylovSolver::BiCgStab(const LinearOperator &a, const double *b,
+                                   double *x, const Preconditioner *m) {
+    const int32_t n = size_;
+    double *r = work_.data(), *r_hat = r + n, *p = r_hat + n, *v = p + n;
+    double *y = v + n, *s = y + n, *z = s + n, *t = z + n;
+    const double b_norm = norm(n, b);
+
+    residual(a, n, b, x, r);
+    double res = norm(n, r) / b_norm;
+    std::copy(r, r + n, r_hat);
+    std::fill(p, p + n, 0.0);
+    std::fill(v, v + n, 0.0);
+    double rho = 1.0, alpha = 1.0, omega = 1.0;
+
+    int32_t it = 0;
+    for (; it < max_iterations_ && res > tolerance_; ++it) {
+        const double rho_next = dot(n, r_hat, r);
+        if (rho_next == 0.0 || omega == 0.0)
+            break;
+
+        const double beta = (rho_next / rho) * (alpha / omega);
+        rho = rho_next;
+        for (int32_t i = 0; i < n; ++i)
+            p[i] = r[i] + beta * (p[i] - omega * v[i]);
+
+        precondition(m, n, p, y);
+        a(y, v);
+        const double r_hat_v = dot(n, r_hat, v);
+        if (r_hat_v == 0.0)
+            break;
+        alpha = rho / r_hat_v;
+        axpy(n, alpha, y, x);
+        for (int32_t i = 0; i < n; ++i)
+            s[i] = r[i] - alpha * v[i];
+
+        res = norm(n, s) / b_norm;
+        if (res <= tolerance_) {
+            ++it;
+            break;
+        }
+
+        precondition(m, n, s, z);
+        a(z, t);
+        const double tt = dot(n, t, t);
+        omega = tt > 0.0 ? dot(n, t, s) / tt : 0.0;
+        axpy(n, omega, z, x);
+        for (int32_t i = 0; i < n; ++i)
+            r[i] = s[i] - omega * t[i];
+        res = norm(n, r) / b_norm;
+    }
+
+    return {it, res, res <= tolerance_};
+}
+
+// Right preconditioned GMRES(restart): the basis spans A M^-1, so the
+// tracked residual is the true one and x moves by M^-1 V y.
+SolverStats KrylovSolver::Gmres(const LinearOperator &a, const double *b,
+                                double *x, const Preconditioner *m) {
+    const int32_t n = size_, k = restart_;
+    double *basis = work_.data();
+    double *w = basis + static_cast<ptrdiff_t>(k + 1) * n, *u = w + n;
+    double *h = hessenberg_.data();
+    double *cs = h + static_cast<ptrdiff_t>(k + 1) * k, *sn = cs + k + 1;
+    double *g = sn + k + 1;
+    auto v = [&](int32_t j) { return basis + static_cast<ptrdiff_t>(j) * n; };
+    auto at = [&](int32_t i, int32_t j) -> double & { return h[i * k + j]; };
+    const double b_norm = norm(n, b);
+
+    residual(a, n, b, x, v(0));
+    double res = norm(n, v(0)) / b_norm;
+    int32_t it = 0;
+    while (it < max_iterations_ && res > tolerance_) {
+        const double beta = norm(n, v(0));
+        for (int32_t i = 0; i < n; ++i)
+            v(0)[i] /= beta;
+        std::fill(g, g + k + 1, 0.0);
+        g[0] = beta;
+
+        int32_t j = 0;
+        for (; j < k && it < max_iterations_ && res > tolerance_; ++j, ++it) {
+            precondition(m, n, v(j), u);
+            a(u, w);
+            // Modified Gram-Schmidt against the basis so far.
+            for (int32_t i = 0; i <= j; ++i) {
+                at(i, j) = dot(n, w, v(i));
+                axpy(n, -at(i, j), v(i), w);
+            }
+            at(j + 1, j) = norm(n, w);
+            if (at(j + 1, j) != 0.0)
+                for (int32_t i = 0; i < n; ++i)
+                    v(j + 1)[i] = w[i] / at(j + 1, j);
+
+            for (int32_t i = 0; i < j; ++i) {
+                const double temp = cs[i] * at(i, j) + sn[i] * at(i + 1, j);
+                at(i + 1, j) = -sn[i] * at(i, j) + cs[i] * at(i + 1, j);
+                at(i, j) = temp;
+            }
+            const double r = std::hypot(at(j, j), at(j + 1, j));
+            if (r == 0.0)
+                break;
+            cs[j] = at(j, j) / r;
+            sn[j] = at(j + 1, j) / r;
+            at(j, j) = r;
+            at(j + 1, j) = 0.0;
+            g[j + 1] = -sn[j] * g[j];
+            g[j] *= cs[j];
+            res = std::fabs(g[j + 1]) / b_norm;
+        }
+
+        // Back substitution for the projected problem, then x += M^-1 V y.
+        for (int32_t i = j - 1; i >= 0; --i) {
+            double sum = g[i];
+            for (int32_t l = i + 1; l < j; ++l)
+                sum -= at(i, l) * g[l];
+            g[i] = sum / at(i, i);
+        }
+        std::fill(w, w + n, 0.0);
+        for (int32_t i = 0; i < j; ++i)
+            axpy(n, g[i], v(i), w);
+        precondition(m, n, w, u);
+        axpy(n, 1.0, u, x);
+
+        residual(a, n, b, x, v(0));
+        res = norm(n, v(0)) / b_norm;
+        if (j == 0)
+            break;
+    }
+
+    return {it, res, res <= tolerance_};
+}
+
+}  // namespace s21
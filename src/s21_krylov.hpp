@@ -0,0 +1,101 @@
+#ifndef SRC_S21_KRYLOV_H_
+#define SRC_S21_KRYLOV_H_
+
+#include <functional>
+#include <vector>
+
+#include "s21_matrix_oop.hpp"
+
+namespace s21 {
+
+// y = A x for vectors of the solver size. Lets a solver run on matrices
+// stored in any format, only their product with a vector is needed.
+using LinearOperator = std::function<void(const double *x, double *y)>;
+
+// Approximates z = M^-1 r for some M close to A.
+class Preconditioner {
+  public:
+    virtual ~Preconditioner() = default;
+    virtual void Apply(const double *r, double *z) const = 0;
+};
+
+// M = diag(A).
+class JacobiPreconditioner final : public Preconditioner {
+  private:
+    std::vector<double> inverse_diagonal_;
+
+  public:
+    explicit JacobiPreconditioner(const S21Matrix &a);
+
+    void Apply(const double *r, double *z) const override;
+};
+
+// M = L U, an LU factorization restricted to the nonzero pattern of A.
+// The factors are kept in compressed rows, so applying costs one pass over
+// the nonzeros of A.
+class Ilu0Preconditioner final : public Preconditioner {
+  private:
+    int32_t size_;
+    std::vector<int64_t> row_start_;
+    std::vector<int32_t> col_;
+    std::vector<double> value_;
+    std::vector<int64_t> diagonal_;
+
+  public:
+    explicit Ilu0Preconditioner(const S21Matrix &a);
+
+    void Apply(const double *r, double *z) const override;
+};
+
+struct SolverStats {
+    int32_t iterations;
+    // ||b - A x|| / ||b|| as tracked by the iteration.
+    double residual;
+    bool converged;
+};
+
+// Iterative solver for A x = b. All the vectors an iteration needs are
+// allocated once by the constructor and reused by every Solve(). x holds
+// the initial guess and receives the solution.
+//  - kCg needs A symmetric positive definite (and M too),
+//  - kGmres restarts every get_restart() iterations,
+//  - kBiCgStab works on any nonsingular A with short recurrences.
+class KrylovSolver {
+  public:
+    enum class Method { kCg, kGmres, kBiCgStab };
+
+  private:
+    Method method_;
+    int32_t size_;
+    int32_t restart_;
+    double tolerance_;
+    int32_t max_iterations_;
+    std::vector<double> work_;
+    std::vector<double> hessenberg_;
+
+    SolverStats Cg(const LinearOperator &a, const double *b, double *x,
+                   const Preconditioner *m);
+    SolverStats Gmres(const LinearOperator &a, const double *b, double *x,
+                      const Preconditioner *m);
+    SolverStats BiCgStab(const LinearOperator &a, const double *b, double *x,
+                         const Preconditioner *m);
+
+  public:
+    KrylovSolver(Method method, int32_t size, int32_t restart = 30);
+
+    int32_t get_size() const noexcept;
+    int32_t get_restart() const noexcept;
+    double get_tolerance() const noexcept;
+    int32_t get_max_iterations() const noexcept;
+    void set_tolerance(double tolerance);
+    void set_max_iterations(int32_t max_iterations);
+
+    SolverStats Solve(const LinearOperator &a, const S21Matrix &b, S21Matrix &x,
+                      const Preconditioner *m = nullptr);
+    SolverStats Solve(const S21Matrix &a, const S21Matrix &b, S21Matrix &x,
+                      const Preconditioner *m = nullptr);
+};
+
+}  // namespace s21
+
+#endif  // SRC_S21_KRYLOV_H_
@@ -0,0 +1,1078 @@
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+#include "s21_kernels.hpp"
+#include "s21_matrix_oop.hpp"
+#include "s21_parallel.hpp"
+#include "s21_trace.hpp"
+
+namespace {
+
+using s21::kernel::View;
+
+constexpr double kEps = 0x1p-52;
+constexpr double kTiny = 0x1p-966;
+
+// The reductions build kPanel reflectors at a time with matrix-vector
+// products and update the rest of the matrix once per panel through GEMM.
+constexpr int32_t kPanel = 32;
+
+// Divide and conquer hands tridiagonal blocks this small to QL.
+constexpr int32_t kLeaf = 32;
+
+// Column width of the pieces the symmetric updates are split into, only
+// the lower triangle of a symmetric matrix is kept up to date.
+constexpr int32_t kSymvBlock = 128;
+
+// Most partial vectors a symmetric matrix-vector product keeps at once.
+constexpr int32_t kSymvPartials = 16;
+
+// Rows of the singular vectors a batch of QR rotations is applied to at a
+// time.
+constexpr int32_t kRotationRows = 16;
+
+// All working buffers below are column-major so that the Householder
+// reflections and Givens rotations sweep contiguous memory.
+class ColMajor {
+  public:
+    ColMajor(int32_t rows, int32_t cols)
+        : rows_(rows), data_(static_cast<size_t>(rows) * cols) {
+    }
+
+    double &operator()(int32_t row, int32_t col) {
+        return data_[static_cast<size_t>(col) * rows_ + row];
+    }
+
+    double *col(int32_t col) {
+        return data_.data() + static_cast<size_t>(col) * rows_;
+    }
+
+    double *data() {
+        return data_.data();
+    }
+
+  private:
+    int32_t rows_;
+    std::vector<double> data_;
+};
+
+void rotate(double *x, double *y, int32_t n, double cs, double sn) {
+    for (int32_t i = 0; i < n; ++i) {
+        double t = cs * x[i] + sn * y[i];
+        y[i] = -sn * x[i] + cs * y[i];
+        x[i] = t;
+    }
+}
+
+// Element (i, j) of a column-major block with leading dimension ld, or of
+// its transpose.
+View cm_view(const double *data, int32_t ld, bool trans) {
+    return trans ? View{data, ld, 1} : View{data, 1, ld};
+}
+
+// c (m x n, column-major) = alpha * a * b + beta * c. The row-major kernel
+// computes c^T = b^T * a^T, which has the same storage.
+void gemm_cm(int32_t m, int32_t n, int32_t k, double alpha, View a, View b,
+             double beta, double *c, int32_t ldc) {
+    if (m == 0 || n == 0)
+        return;
+    s21::kernel::gemm(n, m, k, alpha, View{b.data, b.col_stride, b.row_stride},
+                      View{a.data, a.col_stride, a.row_stride}, beta, c, ldc);
+}
+
+// y = alpha * op(a) * x + beta * y for a column-major m x n block, x and y
+// may be strided to address a row.
+void gemv_cm(int32_t m, int32_t n, double alpha, const double *a, int32_t lda,
+             bool trans, const double *x, int32_t incx, double beta,
+             double *y, int32_t incy) {
+    const int32_t len = trans ? n : m;
+    for (int32_t i = 0; i < len; ++i)
+        y[i * incy] = beta == 0.0 ? 0.0 : beta * y[i * incy];
+    if (m == 0 || n == 0 || alpha == 0.0)
+        return;
+
+    if (trans) {
+        s21::parallel_for(
+            n, std::max<int64_t>(1, s21::parallel_cutoff() / m),
+            [&](int64_t first, int64_t last) {
+                for (int64_t j = first; j < last; ++j) {
+                    const double *col = a + j * lda;
+                    double t = 0.0;
+                    if (incx == 1)
+                        t = s21::kernel::dot(m, col, x);
+                    else
+                        for (int32_t i = 0; i < m; ++i)
+                            t += col[i] * x[i * incx];
+                    y[j * incy] += alpha * t;
+                }
+            });
+        return;
+    }
+
+    // Threads take whole row ranges, so each y element is still summed in
+    // column order.
+    s21::parallel_for(
+        m, std::max<int64_t>(1, s21::parallel_cutoff() / n),
+        [&](int64_t first, int64_t last) {
+            const int32_t rows = static_cast<int32_t>(last - first);
+            for (int32_t j = 0; j < n; ++j) {
+                const double t = alpha * x[j * incx];
+                const double *col = a + static_cast<ptrdiff_t>(j) * lda + first;
+                if (incy == 1)
+                    s21::kernel::axpy(rows, t, col, y + first);
+                else
+                    for (int32_t i = 0; i < rows; ++i)
+                        y[(first + i) * incy] += t * col[i];
+            }
+        });
+}
+
+// y = A * x for the symmetric len x len block whose lower triangle is at a,
+// each stored element is read once. Column blocks whose width depends only
+// on len sum into their own partial vector and the partials are added in
+// order, so the result doesn't depend on the thread count. Blocks widen
+// past kSymvBlock so there are never more than kSymvPartials of them.
+void symv_lower(int32_t len, const double *a, int32_t lda, const double *x,
+                double *y) {
+    const int32_t width =
+        std::max(kSymvBlock, (len + kSymvPartials - 1) / kSymvPartials);
+    const int32_t blocks = (len + width - 1) / width;
+    std::vector<double> partial(static_cast<size_t>(blocks) * len);
+    s21::parallel_for(
+        blocks,
+        std::max<int64_t>(1, s21::parallel_cutoff() / (int64_t{len} * width)),
+        [&](int64_t first, int64_t last) {
+            for (int64_t b = first; b < last; ++b) {
+                double *part = partial.data() + b * len;
+                const int32_t j0 = static_cast<int32_t>(b * width);
+                const int32_t j1 = std::min(len, j0 + width);
+                for (int32_t j = j0; j < j1; ++j) {
+                    const double *col = a + static_cast<ptrdiff_t>(j) * lda;
+                    const int32_t tail = len - j - 1;
+                    part[j] += col[j] * x[j] +
+                               s21::kernel::dot(tail, col + j + 1, x + j + 1);
+                    s21::kernel::axpy(tail, x[j], col + j + 1, part + j + 1);
+                }
+            }
+        });
+
+    std::copy(partial.begin(), partial.begin() + len, y);
+    for (int32_t b = 1; b < blocks; ++b) {
+        const double *part = partial.data() + static_cast<size_t>(b) * len;
+        for (int32_t i = b * width; i < len; ++i)
+            y[i] += part[i];
+    }
+}
+
+// Builds H = I - tau * v * v^T with v = (1, x) such that H * (alpha, x) =
+// (beta, 0); alpha becomes beta and x the tail of v. n counts alpha too.
+double householder(int32_t n, double &alpha, double *x, int32_t incx) {
+    if (n <= 1)
+        return 0.0;
+
+    double scale = 0.0;
+    for (int32_t i = 0; i < n - 1; ++i)
+        scale = std::max(scale, std::fabs(x[i * incx]));
+    if (scale == 0.0)
+        return 0.0;
+
+    double ssq = 0.0;
+    for (int32_t i = 0; i < n - 1; ++i) {
+        const double t = x[i * incx] / scale;
+        ssq += t * t;
+    }
+    const double beta =
+        -std::copysign(std::hypot(alpha, scale * std::sqrt(ssq)), alpha);
+    const double tau = (beta - alpha) / beta;
+    const double f = 1.0 / (alpha - beta);
+    for (int32_t i = 0; i < n - 1; ++i)
+        x[i * incx] *= f;
+    alpha = beta;
+    return tau;
+}
+
+// Copies nb reflectors into a dense len x nb block with the unit entries
+// and the zeros above them filled in. Vector c has its unit entry at row c
+// and row r > c is src[r * step + c * next].
+std::vector<double> reflector_block(const double *src, ptrdiff_t step,
+                                    ptrdiff_t next, int32_t len, int32_t nb) {
+    std::vector<double> v(static_cast<size_t>(len) * nb);
+    for (int32_t c = 0; c < nb; ++c) {
+        double *col = v.data() + static_cast<size_t>(c) * len;
+        col[c] = 1.0;
+        for (int32_t r = c + 1; r < len; ++r)
+            col[r] = src[r * step + c * next];
+    }
+    return v;
+}
+
+// x (len x cols) = H_0 * H_1 * ... * H_{nb-1} * x, with the product of the
+// reflectors in v written as I - V * T * V^T so it costs three GEMMs.
+void apply_block(int32_t len, int32_t nb, const double *v, const double *tau,
+                 double *x, int32_t ldx, int32_t cols) {
+    std::vector<double> t(static_cast<size_t>(nb) * nb);
+    std::vector<double> tmp(nb);
+    for (int32_t c = 0; c < nb; ++c) {
+        t[c + c * nb] = tau[c];
+        if (c == 0 || tau[c] == 0.0)
+            continue;
+        gemv_cm(len, c, -tau[c], v, len, true, v + c * len, 1, 0.0,
+                tmp.data(), 1);
+        for (int32_t r = 0; r < c; ++r) {
+            double s = 0.0;
+            for (int32_t q = r; q < c; ++q)
+                s += t[r + q * nb] * tmp[q];
+            t[r + c * nb] = s;
+        }
+    }
+
+    // W = V^T x and T W are kept row-major so the kernel sweeps the long
+    // side of them.
+    std::vector<double> w(static_cast<size_t>(nb) * cols);
+    std::vector<double> tw(static_cast<size_t>(nb) * cols);
+    s21::kernel::gemm(nb, cols, len, 1.0, cm_view(v, len, true),
+                      cm_view(x, ldx, false), 0.0, w.data(), cols);
+    s21::kernel::gemm(nb, cols, nb, 1.0, cm_view(t.data(), nb, false),
+                      View{w.data(), cols, 1}, 0.0, tw.data(), cols);
+    gemm_cm(len, cols, nb, -1.0, cm_view(v, len, false),
+            View{tw.data(), cols, 1}, 1.0, x, ldx);
+}
+
+// Blocked Householder reduction of a symmetric matrix to tridiagonal form,
+// A = Q T Q^T, only the lower triangle of a is used. Each panel of
+// reflectors also produces W such that the trailing matrix is brought up
+// to date with the rank-2k update A -= V W^T + W V^T. Reflector j is kept
+// below the subdiagonal of column j with its unit entry stored explicitly.
+void tridiagonalize(ColMajor &a, int32_t n, double *d, double *e,
+                    double *tau) {
+    std::vector<double> w(static_cast<size_t>(n) * kPanel);
+    double tmp[kPanel];
+    auto wcol = [&](int32_t row, int32_t c) {
+        return w.data() + static_cast<size_t>(c) * n + row;
+    };
+
+    for (int32_t p = 0; p < n - 1; p += kPanel) {
+        const int32_t nb = std::min(kPanel, n - 1 - p);
+        for (int32_t c = 0; c < nb; ++c) {
+            const int32_t j = p + c;
+            if (c > 0) {
+                gemv_cm(n - j, c, -1.0, &a(j, p), n, false, wcol(j, 0), n, 1.0,
+                        &a(j, j), 1);
+                gemv_cm(n - j, c, -1.0, wcol(j, 0), n, false, &a(j, p), n, 1.0,
+                        &a(j, j), 1);
+            }
+            d[j] = a(j, j);
+
+            const int32_t len = n - 1 - j;
+            tau[j] = householder(len, a(j + 1, j), &a(std::min(j + 2, n - 1), j), 1);
+            e[j] = a(j + 1, j);
+            a(j + 1, j) = 1.0;
+
+            const double *v = &a(j + 1, j);
+            double *wc = wcol(j + 1, c);
+            symv_lower(len, &a(j + 1, j + 1), n, v, wc);
+            if (c > 0) {
+                gemv_cm(len, c, 1.0, wcol(j + 1, 0), n, true, v, 1, 0.0, tmp, 1);
+                gemv_cm(len, c, -1.0, &a(j + 1, p), n, false, tmp, 1, 1.0, wc, 1);
+                gemv_cm(len, c, 1.0, &a(j + 1, p), n, true, v, 1, 0.0, tmp, 1);
+                gemv_cm(len, c, -1.0, wcol(j + 1, 0), n, false, tmp, 1, 1.0, wc, 1);
+            }
+            for (int32_t i = 0; i < len; ++i)
+                wc[i] *= tau[j];
+            const double alpha = -0.5 * tau[j] * s21::kernel::dot(len, wc, v);
+            s21::kernel::axpy(len, alpha, v, wc);
+        }
+
+        // Column blocks of the trailing matrix from their diagonal down.
+        for (int32_t c0 = p + nb; c0 < n; c0 += kSymvBlock) {
+            const int32_t cb = std::min(kSymvBlock, n - c0);
+            gemm_cm(n - c0, cb, nb, -1.0, cm_view(&a(c0, p), n, false),
+                    cm_view(wcol(c0, 0), n, true), 1.0, &a(c0, c0), n);
+            gemm_cm(n - c0, cb, nb, -1.0, cm_view(wcol(c0, 0), n, false),
+                    cm_view(&a(c0, p), n, true), 1.0, &a(c0, c0), n);
+        }
+    }
+    d[n - 1] = a(n - 1, n - 1);
+}
+
+// z = Q * z for the Q left in a by tridiagonalize, one panel at a time in
+// reverse order.
+void apply_q(ColMajor &a, const double *tau, ColMajor &z, int32_t n) {
+    if (n < 2)
+        return;
+    for (int32_t p = (n - 2) / kPanel * kPanel; p >= 0; p -= kPanel) {
+        const int32_t nb = std::min(kPanel, n - 1 - p);
+        const int32_t len = n - 1 - p;
+        std::vector<double> v = reflector_block(&a(p + 1, p), 1, n, len, nb);
+        apply_block(len, nb, v.data(), tau + p, &z(p + 1, 0), n, n);
+    }
+}
+
+// Implicit QL iteration with Wilkinson shifts on the tridiagonal matrix.
+void tridiagonal_ql(ColMajor &v, std::vector<double> &d, std::vector<double> &e,
+                    int32_t n) {
+    for (int32_t i = 1; i < n; ++i)
+        e[i - 1] = e[i];
+    e[n - 1] = 0.0;
+
+    double f = 0.0;
+    double tst1 = 0.0;
+    for (int32_t l = 0; l < n; ++l) {
+        tst1 = std::max(tst1, std::fabs(d[l]) + std::fabs(e[l]));
+        int32_t m = l;
+        while (m < n - 1 && std::fabs(e[m]) > kEps * tst1)
+            ++m;
+
+        if (m > l) {
+            do {
+                double g = d[l];
+                double p = (d[l + 1] - g) / (2.0 * e[l]);
+                double r = std::hypot(p, 1.0);
+                if (p < 0)
+                    r = -r;
+                d[l] = e[l] / (p + r);
+                d[l + 1] = e[l] * (p + r);
+                double dl1 = d[l + 1];
+                double h = g - d[l];
+                for (int32_t i = l + 2; i < n; ++i)
+                    d[i] -= h;
+                f += h;
+
+                p = d[m];
+                double c = 1.0, c2 = 1.0, c3 = 1.0;
+                double el1 = e[l + 1];
+                double s = 0.0, s2 = 0.0;
+                for (int32_t i = m - 1; i >= l; --i) {
+                    c3 = c2;
+                    c2 = c;
+                    s2 = s;
+                    g = c * e[i];
+                    h = c * p;
+                    r = std::hypot(p, e[i]);
+                    e[i + 1] = s * r;
+                    s = e[i] / r;
+                    c = p / r;
+                    p = c * d[i] - s * g;
+                    d[i + 1] = h + s * (c * g + s * d[i]);
+                    rotate(v.col(i + 1), v.col(i), n, c, s);
+                }
+                p = -s * s2 * c3 * el1 * e[l] / dl1;
+                e[l] = s * p;
+                d[l] = c * p;
+            } while (std::fabs(e[l]) > kEps * tst1);
+        }
+        d[l] += f;
+        e[l] = 0.0;
+    }
+}
+
+// Writes the eigenpairs (vals[i], column i of vecs) to d and the n x n
+// block at z in ascending order.
+void store_sorted(int32_t n, const double *vals, const double *vecs,
+                  int32_t ldv, double *d, double *z, int32_t ldz) {
+    std::vector<int32_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+              [vals](int32_t a, int32_t b) { return vals[a] < vals[b]; });
+    for (int32_t j = 0; j < n; ++j) {
+        d[j] = vals[order[j]];
+        const double *src = vecs + static_cast<ptrdiff_t>(order[j]) * ldv;
+        std::copy(src, src + n, z + static_cast<ptrdiff_t>(j) * ldz);
+    }
+}
+
+void tridiagonal_leaf(int32_t n, double *d, const double *e, double *z,
+                      int32_t ldz) {
+    ColMajor v(n, n);
+    for (int32_t i = 0; i < n; ++i)
+        v(i, i) = 1.0;
+    std::vector<double> dv(d, d + n);
+    std::vector<double> ev(n);
+    for (int32_t i = 1; i < n; ++i)
+        ev[i] = e[i - 1];
+
+    tridiagonal_ql(v, dv, ev, n);
+    store_sorted(n, dv.data(), v.data(), n, d, z, ldz);
+}
+
+// Root i (counted from the left) of the secular equation
+// 1 / rho + sum_j z_j^2 / (d_j - x) = 0 for ascending poles d and rho > 0.
+// Each step fits the two poles around the root exactly and the others by
+// their derivative (Li's "middle way"), bisection keeps it inside the
+// bracket. delta[j] receives d_j - x, computed from the nearest pole so it
+// keeps its relative accuracy.
+double secular_root(int32_t k, const double *d, const double *z, double rho,
+                    int32_t i, double *delta) {
+    const bool last = i == k - 1;
+    int32_t origin = i;
+    double lo = 0.0;
+    double hi = 0.0;
+    if (last) {
+        for (int32_t j = 0; j < k; ++j)
+            hi += z[j] * z[j];
+        hi *= rho;
+    } else {
+        const double gap = d[i + 1] - d[i];
+        const double mid = gap / 2.0;
+        double g = 1.0 / rho;
+        for (int32_t j = 0; j < k; ++j)
+            g += z[j] * z[j] / ((d[j] - d[i]) - mid);
+        if (g >= 0.0) {
+            hi = mid;
+        } else {
+            origin = i + 1;
+            lo = mid - gap;
+        }
+    }
+
+    const double base = d[origin];
+    for (int32_t j = 0; j < k; ++j)
+        delta[j] = d[j] - base;
+
+    double tau = (lo + hi) / 2.0;
+    for (int32_t iter = 0; iter < 100; ++iter) {
+        double psi = 0.0, dpsi = 0.0, phi = 0.0, dphi = 0.0;
+        for (int32_t j = 0; j <= i; ++j) {
+            const double t = z[j] / (delta[j] - tau);
+            psi += z[j] * t;
+            dpsi += t * t;
+        }
+        for (int32_t j = i + 1; j < k; ++j) {
+            const double t = z[j] / (delta[j] - tau);
+            phi += z[j] * t;
+            dphi += t * t;
+        }
+
+        const double w = 1.0 / rho + psi + phi;
+        if (w < 0.0)
+            lo = tau;
+        else
+            hi = tau;
+        const double err =
+            8.0 * (phi - psi) + 2.0 / rho + 3.0 * std::fabs(tau) * (dpsi + dphi);
+        if (std::fabs(w) <= kEps * err)
+            break;
+
+        const double di = delta[i] - tau;
+        double eta = 0.0;
+        if (last) {
+            const double s = di * di * dpsi;
+            eta = di + s / (w - s / di);
+        } else {
+            const double di1 = delta[i + 1] - tau;
+            const double s = di * di * dpsi;
+            const double r = di1 * di1 * dphi;
+            const double c = w - s / di - r / di1;
+            const double a = c * (di + di1) + s + r;
+            const double b = di * di1 * w;
+            if (c == 0.0) {
+                eta = b / a;
+            } else {
+                const double disc = std::sqrt(std::max(0.0, a * a - 4.0 * b * c));
+                eta = a >= 0.0 ? 2.0 * b / (a + disc) : (a - disc) / (2.0 * c);
+            }
+        }
+
+        double next = tau + eta;
+        if (!(next > lo && next < hi))
+            next = (lo + hi) / 2.0;
+        const bool done = std::fabs(next - tau) <=
+                          2.0 * kEps * std::max(std::fabs(lo), std::fabs(hi));
+        tau = next;
+        if (done)
+            break;
+    }
+
+    for (int32_t j = 0; j < k; ++j)
+        delta[j] -= tau;
+    return base + tau;
+}
+
+enum Rows { kUpper, kBoth, kLower };
+
+// Merges the halves [0, m) and [m, n) of a tridiagonal matrix that was torn
+// at the coupling beta. With Q = diag(Q1, Q2) holding the eigenvectors of
+// the halves, what is left is the rank-one update D + rho * u * u^T.
+void tridiagonal_merge(int32_t n, int32_t m, double beta, double *d, double *z,
+                       int32_t ldz) {
+    const double rho = 2.0 * std::fabs(beta);
+    const double sign = beta < 0.0 ? -1.0 : 1.0;
+    auto zcol = [&](int32_t c) { return z + static_cast<ptrdiff_t>(c) * ldz; };
+
+    std::vector<int32_t> col(n);
+    std::iota(col.begin(), col.end(), 0);
+    std::sort(col.begin(), col.end(),
+              [d](int32_t a, int32_t b) { return d[a] < d[b]; });
+
+    std::vector<double> ds(n);
+    std::vector<double> zs(n);
+    std::vector<Rows> rows(n);
+    double dmax = 0.0;
+    double zmax = 0.0;
+    for (int32_t t = 0; t < n; ++t) {
+        const int32_t c = col[t];
+        ds[t] = d[c];
+        zs[t] = (c < m ? zcol(c)[m - 1] : sign * zcol(c)[m]) / std::sqrt(2.0);
+        rows[t] = c < m ? kUpper : kLower;
+        dmax = std::max(dmax, std::fabs(ds[t]));
+        zmax = std::max(zmax, std::fabs(zs[t]));
+    }
+
+    // Deflation: a negligible u component leaves its eigenpair as it is, and
+    // of two close poles a rotation moves the whole component onto one.
+    const double tol = 8.0 * kEps * std::max(dmax, zmax);
+    std::vector<int32_t> kept;
+    std::vector<int32_t> deflated;
+    int32_t prev = -1;
+    for (int32_t j = 0; j < n; ++j) {
+        if (rho * std::fabs(zs[j]) <= tol) {
+            deflated.push_back(j);
+            continue;
+        }
+        if (prev < 0) {
+            prev = j;
+            continue;
+        }
+
+        const double r = std::hypot(zs[j], zs[prev]);
+        const double c = zs[j] / r;
+        const double s = -zs[prev] / r;
+        if (std::fabs((ds[j] - ds[prev]) * c * s) <= tol) {
+            zs[j] = r;
+            zs[prev] = 0.0;
+            rotate(zcol(col[prev]), zcol(col[j]), n, c, s);
+            const double dp = ds[prev] * c * c + ds[j] * s * s;
+            ds[j] = ds[prev] * s * s + ds[j] * c * c;
+            ds[prev] = dp;
+            if (rows[prev] != rows[j])
+                rows[prev] = rows[j] = kBoth;
+            deflated.push_back(prev);
+        } else {
+            kept.push_back(prev);
+        }
+        prev = j;
+    }
+    if (prev >= 0)
+        kept.push_back(prev);
+
+    // Secular equation, then the eigenvectors of the rank-one problem from
+    // a z recomputed out of the roots (Gu and Eisenstat), which keeps them
+    // orthogonal however close the roots are.
+    const int32_t k = static_cast<int32_t>(kept.size());
+    std::vector<double> poles(k);
+    std::vector<double> weights(k);
+    for (int32_t i = 0; i < k; ++i) {
+        poles[i] = ds[kept[i]];
+        weights[i] = zs[kept[i]];
+    }
+
+    std::vector<double> vals(n);
+    std::vector<double> u(static_cast<size_t>(k) * k);
+    for (int32_t i = 0; i < k; ++i)
+        vals[i] = secular_root(k, poles.data(), weights.data(), rho, i,
+                               u.data() + static_cast<size_t>(i) * k);
+
+    std::vector<double> zhat(k);
+    for (int32_t j = 0; j < k; ++j)
+        zhat[j] = u[j + static_cast<size_t>(j) * k];
+    for (int32_t c = 0; c < k; ++c)
+        for (int32_t j = 0; j < k; ++j)
+            if (j != c)
+                zhat[j] *= u[j + static_cast<size_t>(c) * k] /
+                           (poles[j] - poles[c]);
+    for (int32_t j = 0; j < k; ++j)
+        zhat[j] = std::copysign(std::sqrt(std::max(0.0, -zhat[j])), weights[j]);
+
+    for (int32_t c = 0; c < k; ++c) {
+        double *uc = u.data() + static_cast<size_t>(c) * k;
+        for (int32_t j = 0; j < k; ++j)
+            uc[j] = zhat[j] / uc[j];
+        const double norm = std::sqrt(s21::kernel::dot(k, uc, uc));
+        for (int32_t j = 0; j < k; ++j)
+            uc[j] /= norm;
+    }
+
+    // Back to the original basis. Columns that came from one half are zero
+    // in the rows of the other, so each half of the rows only multiplies
+    // the columns that reach it.
+    std::vector<double> out(static_cast<size_t>(n) * n);
+    auto multiply = [&](int32_t row0, int32_t height, Rows skip) {
+        std::vector<int32_t> idx;
+        for (int32_t i = 0; i < k; ++i)
+            if (rows[kept[i]] != skip)
+                idx.push_back(i);
+        const int32_t cnt = static_cast<int32_t>(idx.size());
+        if (cnt == 0)
+            return;
+
+        std::vector<double> qg(static_cast<size_t>(height) * cnt);
+        std::vector<double> ug(static_cast<size_t>(cnt) * k);
+        for (int32_t r = 0; r < cnt; ++r) {
+            const double *src = zcol(col[kept[idx[r]]]) + row0;
+            std::copy(src, src + height, qg.data() + static_cast<size_t>(r) * height);
+            for (int32_t c = 0; c < k; ++c)
+                ug[r + static_cast<size_t>(c) * cnt] =
+                    u[idx[r] + static_cast<size_t>(c) * k];
+        }
+        gemm_cm(height, k, cnt, 1.0, cm_view(qg.data(), height, false),
+                cm_view(ug.data(), cnt, false), 0.0, out.data() + row0, n);
+    };
+    multiply(0, m, kLower);
+    multiply(m, n - m, kUpper);
+
+    for (size_t r = 0; r < deflated.size(); ++r) {
+        const int32_t t = deflated[r];
+        vals[k + r] = ds[t];
+        std::copy(zcol(col[t]), zcol(col[t]) + n,
+                  out.data() + static_cast<size_t>(k + r) * n);
+    }
+    store_sorted(n, vals.data(), out.data(), n, d, z, ldz);
+}
+
+// Cuppen's divide and conquer for the symmetric tridiagonal matrix with
+// diagonal d and off-diagonal e (e[i] couples i and i + 1). On return d is
+// ascending and the n x n block at z, zero on entry, holds the eigenvectors.
+void tridiagonal_dc(int32_t n, double *d, double *e, double *z, int32_t ldz) {
+    if (n <= kLeaf) {
+        tridiagonal_leaf(n, d, e, z, ldz);
+        return;
+    }
+
+    const int32_t m = n / 2;
+    const double beta = e[m - 1];
+    d[m - 1] -= std::fabs(beta);
+    d[m] -= std::fabs(beta);
+    tridiagonal_dc(m, d, e, z, ldz);
+    tridiagonal_dc(n - m, d + m, e + m, z + m + static_cast<ptrdiff_t>(m) * ldz,
+                   ldz);
+    tridiagonal_merge(n, m, beta, d, z, ldz);
+}
+
+void tridiagonal_eigen(int32_t n, double *d, double *e, ColMajor &z) {
+    double scale = 0.0;
+    for (int32_t i = 0; i < n; ++i)
+        scale = std::max(scale, std::fabs(d[i]));
+    for (int32_t i = 0; i < n - 1; ++i)
+        scale = std::max(scale, std::fabs(e[i]));
+    if (scale == 0.0) {
+        for (int32_t i = 0; i < n; ++i)
+            z(i, i) = 1.0;
+        return;
+    }
+
+    for (int32_t i = 0; i < n; ++i)
+        d[i] /= scale;
+    for (int32_t i = 0; i < n - 1; ++i)
+        e[i] /= scale;
+    tridiagonal_dc(n, d, e, z.data(), n);
+    for (int32_t i = 0; i < n; ++i)
+        d[i] *= scale;
+}
+
+// Blocked Golub-Kahan bidiagonalization of a tall matrix, A = Q B P^T with
+// B upper bidiagonal. The panel produces X and Y such that the trailing
+// matrix is updated with A -= V Y^T + X U^T. Left reflector j is kept in
+// column j from the diagonal down, right reflector j in row j from the
+// superdiagonal on.
+void bidiagonalize(ColMajor &a, int32_t m, int32_t n, double *d, double *e,
+                   double *tauq, double *taup) {
+    std::vector<double> x(static_cast<size_t>(m) * kPanel);
+    std::vector<double> y(static_cast<size_t>(n) * kPanel);
+    double tmp[kPanel];
+    auto xcol = [&](int32_t row, int32_t c) {
+        return x.data() + static_cast<size_t>(c) * m + row;
+    };
+    auto ycol = [&](int32_t row, int32_t c) {
+        return y.data() + static_cast<size_t>(c) * n + row;
+    };
+
+    for (int32_t p = 0; p < n; p += kPanel) {
+        const int32_t nb = std::min(kPanel, n - p);
+        for (int32_t c = 0; c < nb; ++c) {
+            const int32_t i = p + c;
+            if (c > 0) {
+                gemv_cm(m - i, c, -1.0, &a(i, p), m, false, ycol(i, 0), n, 1.0,
+                        &a(i, i), 1);
+                gemv_cm(m - i, c, -1.0, xcol(i, 0), m, false, &a(p, i), 1, 1.0,
+                        &a(i, i), 1);
+            }
+            tauq[i] = householder(m - i, a(i, i), &a(std::min(i + 1, m - 1), i), 1);
+            d[i] = a(i, i);
+            if (i == n - 1)
+                continue;
+
+            const int32_t rest = n - i - 1;
+            a(i, i) = 1.0;
+            double *yc = ycol(i + 1, c);
+            gemv_cm(m - i, rest, 1.0, &a(i, i + 1), m, true, &a(i, i), 1, 0.0,
+                    yc, 1);
+            if (c > 0) {
+                gemv_cm(m - i, c, 1.0, &a(i, p), m, true, &a(i, i), 1, 0.0, tmp, 1);
+                gemv_cm(rest, c, -1.0, ycol(i + 1, 0), n, false, tmp, 1, 1.0, yc, 1);
+                gemv_cm(m - i, c, 1.0, xcol(i, 0), m, true, &a(i, i), 1, 0.0, tmp, 1);
+                gemv_cm(c, rest, -1.0, &a(p, i + 1), m, true, tmp, 1, 1.0, yc, 1);
+            }
+            for (int32_t r = 0; r < rest; ++r)
+                yc[r] *= tauq[i];
+
+            gemv_cm(rest, c + 1, -1.0, ycol(i + 1, 0), n, false, &a(i, p), m,
+                    1.0, &a(i, i + 1), m);
+            if (c > 0)
+                gemv_cm(c, rest, -1.0, &a(p, i + 1), m, true, xcol(i, 0), m,
+                        1.0, &a(i, i + 1), m);
+            taup[i] = householder(rest, a(i, i + 1), &a(i, std::min(i + 2, n - 1)), m);
+            e[i] = a(i, i + 1);
+            a(i, i + 1) = 1.0;
+
+            double *xc = xcol(i + 1, c);
+            gemv_cm(m - i - 1, rest, 1.0, &a(i + 1, i + 1), m, false,
+                    &a(i, i + 1), m, 0.0, xc, 1);
+            gemv_cm(rest, c + 1, 1.0, ycol(i + 1, 0), n, true, &a(i, i + 1), m,
+                    0.0, tmp, 1);
+            gemv_cm(m - i - 1, c + 1, -1.0, &a(i + 1, p), m, false, tmp, 1, 1.0,
+                    xc, 1);
+            if (c > 0) {
+                gemv_cm(c, rest, 1.0, &a(p, i + 1), m, false, &a(i, i + 1), m,
+                        0.0, tmp, 1);
+                gemv_cm(m - i - 1, c, -1.0, xcol(i + 1, 0), m, false, tmp, 1,
+                        1.0, xc, 1);
+            }
+            for (int32_t r = 0; r < m - i - 1; ++r)
+                xc[r] *= taup[i];
+        }
+
+        const int32_t q = p + nb;
+        if (q == n)
+            break;
+        gemm_cm(m - q, n - q, nb, -1.0, cm_view(&a(q, p), m, false),
+                cm_view(ycol(q, 0), n, true), 1.0, &a(q, q), m);
+        gemm_cm(m - q, n - q, nb, -1.0, cm_view(xcol(q, 0), m, false),
+                cm_view(&a(p, q), m, false), 1.0, &a(q, q), m);
+    }
+}
+
+// Rotations of the bidiagonal QR are queued and then applied to the
+// singular vectors kRotationRows rows at a time, so those rows stay in
+// cache while whole sweeps go over them. Rows are independent, the
+// threads split them.
+class RotationQueue {
+  public:
+    RotationQueue(ColMajor &q, int32_t rows) : q_(q), rows_(rows) {
+    }
+
+    ~RotationQueue() {
+        flush();
+    }
+
+    // (x, y) = (cs * x + sn * y, -sn * x + cs * y) for columns x and y
+    void rotate(int32_t x, int32_t y, double cs, double sn) {
+        push({kRotate, x, y, cs, sn});
+    }
+
+    void swap(int32_t x, int32_t y) {
+        push({kSwap, x, y, 0.0, 0.0});
+    }
+
+    void negate(int32_t x) {
+        push({kNegate, x, x, 0.0, 0.0});
+    }
+
+    void flush() {
+        if (ops_.empty())
+            return;
+
+        const int64_t blocks = (rows_ + kRotationRows - 1) / kRotationRows;
+        const int64_t cost = static_cast<int64_t>(ops_.size()) * kRotationRows;
+        s21::parallel_for(
+            blocks, std::max<int64_t>(1, s21::parallel_cutoff() / cost),
+            [&](int64_t first, int64_t last) {
+                for (int64_t b = first; b < last; ++b)
+                    apply(static_cast<int32_t>(b * kRotationRows));
+            });
+        ops_.clear();
+    }
+
+  private:
+    enum Kind { kRotate, kSwap, kNegate };
+
+    struct Op {
+        Kind kind;
+        int32_t x;
+        int32_t y;
+        double cs;
+        double sn;
+    };
+
+    void push(const Op &op) {
+        ops_.push_back(op);
+        if (ops_.size() >= (size_t{1} << 20))
+            flush();
+    }
+
+    void apply(int32_t row0) const {
+        const int32_t len = std::min(kRotationRows, rows_ - row0);
+        for (const Op &op : ops_) {
+            double *x = q_.col(op.x) + row0;
+            double *y = q_.col(op.y) + row0;
+            if (op.kind == kRotate)
+                ::rotate(x, y, len, op.cs, op.sn);
+            else if (op.kind == kSwap)
+                std::swap_ranges(x, x + len, y);
+            else
+                for (int32_t i = 0; i < len; ++i)
+                    x[i] = -x[i];
+        }
+    }
+
+    ColMajor &q_;
+    int32_t rows_;
+    std::vector<Op> ops_;
+};
+
+// Implicit-shift QR on the n x n upper bidiagonal (s, e), the rotations are
+// accumulated in the m x n u and the n x n v. Ends with s descending and
+// positive.
+void bidiagonal_qr(std::vector<double> &s, std::vector<double> &e,
+                   RotationQueue &u, RotationQueue &v, int32_t n) {
+    int32_t p = n;
+    const int32_t pp = p - 1;
+    while (p > 0) {
+        int32_t k = p - 2;
+        for (; k >= 0; --k) {
+            if (std::fabs(e[k]) <=
+                kTiny + kEps * (std::fabs(s[k]) + std::fabs(s[k + 1]))) {
+                e[k] = 0.0;
+                break;
+            }
+        }
+
+        int32_t kase = 0;
+        if (k == p - 2) {
+            kase = 4;
+        } else {
+            int32_t ks = p - 1;
+            for (; ks > k; --ks) {
+                double t = (ks != p ? std::fabs(e[ks]) : 0.0) +
+                           (ks != k + 1 ? std::fabs(e[ks - 1]) : 0.0);
+                if (std::fabs(s[ks]) <= kTiny + kEps * t) {
+                    s[ks] = 0.0;
+                    break;
+                }
+            }
+            if (ks == k) {
+                kase = 3;
+            } else if (ks == p - 1) {
+                kase = 1;
+            } else {
+                kase = 2;
+                k = ks;
+            }
+        }
+        ++k;
+
+        if (kase == 1) {
+            double f = e[p - 2];
+            e[p - 2] = 0.0;
+            for (int32_t j = p - 2; j >= k; --j) {
+                double t = std::hypot(s[j], f);
+                double cs = s[j] / t;
+                double sn = f / t;
+                s[j] = t;
+                if (j != k) {
+                    f = -sn * e[j - 1];
+                    e[j - 1] = cs * e[j - 1];
+                }
+                v.rotate(j, p - 1, cs, sn);
+            }
+        } else if (kase == 2) {
+            double f = e[k - 1];
+            e[k - 1] = 0.0;
+            for (int32_t j = k; j < p; ++j) {
+                double t = std::hypot(s[j], f);
+                double cs = s[j] / t;
+                double sn = f / t;
+                s[j] = t;
+                f = -sn * e[j];
+                e[j] = cs * e[j];
+                u.rotate(j, k - 1, cs, sn);
+            }
+        } else if (kase == 3) {
+            double scale = std::max(
+                {std::fabs(s[p - 1]), std::fabs(s[p - 2]), std::fabs(e[p - 2]),
+                 std::fabs(s[k]), std::fabs(e[k])});
+            double sp = s[p - 1] / scale;
+            double spm1 = s[p - 2] / scale;
+            double epm1 = e[p - 2] / scale;
+            double sk = s[k] / scale;
+            double ek = e[k] / scale;
+            double b = ((spm1 + sp) * (spm1 - sp) + epm1 * epm1) / 2.0;
+            double c = (sp * epm1) * (sp * epm1);
+            double shift = 0.0;
+            if (b != 0.0 || c != 0.0) {
+                shift = std::sqrt(b * b + c);
+                if (b < 0.0)
+                    shift = -shift;
+                shift = c / (b + shift);
+            }
+            double f = (sk + sp) * (sk - sp) + shift;
+            double g = sk * ek;
+
+            for (int32_t j = k; j < p - 1; ++j) {
+                double t = std::hypot(f, g);
+                double cs = f / t;
+                double sn = g / t;
+                if (j != k)
+                    e[j - 1] = t;
+                f = cs * s[j] + sn * e[j];
+                e[j] = cs * e[j] - sn * s[j];
+                g = sn * s[j + 1];
+                s[j + 1] = cs * s[j + 1];
+                v.rotate(j, j + 1, cs, sn);
+
+                t = std::hypot(f, g);
+                cs = f / t;
+                sn = g / t;
+                s[j] = t;
+                f = cs * e[j] + sn * s[j + 1];
+                s[j + 1] = -sn * e[j] + cs * s[j + 1];
+                g = sn * e[j + 1];
+                e[j + 1] = cs * e[j + 1];
+                u.rotate(j, j + 1, cs, sn);
+            }
+            e[p - 2] = f;
+        } else {
+            if (s[k] <= 0.0) {
+                s[k] = (s[k] < 0.0 ? -s[k] : 0.0);
+                v.negate(k);
+            }
+            while (k < pp && s[k] < s[k + 1]) {
+                std::swap(s[k], s[k + 1]);
+                v.swap(k, k + 1);
+                u.swap(k, k + 1);
+                ++k;
+            }
+            --p;
+        }
+    }
+}
+
+}  // namespace
+
+void S21Matrix::SymmetricEigen(S21Matrix &values, S21Matrix &vectors) const {
+    S21_TRACE_SCOPE("SymmetricEigen", rows_, cols_);
+    if (rows_ <= 0 || cols_ <= 0)
+        throw std::logic_error("Can't decompose an empty matrix");
+    if (rows_ != cols_)
+        throw std::logic_error(
+            "The matrix is not square to calculate eigenvalues");
+
+    // Relative to the largest element, a product like A D A^T rounds its
+    // two triangles differently.
+    const int32_t n = rows_;
+    const double tolerance = 1e-07 * std::max(1.0, Norm(NormType::kMax));
+    for (int32_t i = 0; i < n; ++i)
+        for (int32_t j = 0; j < i; ++j)
+            if (std::fabs(matrix_[i * n + j] - matrix_[j * n + i]) > tolerance)
+                throw std::logic_error(
+                    "The matrix is not symmetric to calculate eigenvalues");
+
+    // Tridiagonal reduction, divide and conquer on the tridiagonal matrix,
+    // then the reflectors are applied to its eigenvectors.
+    ColMajor a(n, n);
+    for (int32_t i = 0; i < n; ++i)
+        for (int32_t j = 0; j <= i; ++j)
+            a(i, j) = matrix_[i * n + j];
+
+    std::vector<double> d(n);
+    std::vector<double> e(n);
+    std::vector<double> tau(n);
+    tridiagonalize(a, n, d.data(), e.data(), tau.data());
+
+    ColMajor z(n, n);
+    tridiagonal_eigen(n, d.data(), e.data(), z);
+    apply_q(a, tau.data(), z, n);
+
+    S21Matrix vals(n, 1, uninit);
+    S21Matrix vecs(n, n, uninit);
+    for (int32_t j = 0; j < n; ++j) {
+        vals.matrix_[j] = d[j];
+        for (int32_t i = 0; i < n; ++i)
+            vecs.matrix_[i * n + j] = z(i, j);
+    }
+
+    values = std::move(vals);
+    vectors = std::move(vecs);
+}
+
+void S21Matrix::Svd(S21Matrix &u, S21Matrix &sigma, S21Matrix &v) const {
+    S21_TRACE_SCOPE("Svd", rows_, cols_);
+    if (rows_ <= 0 || cols_ <= 0)
+        throw std::logic_error("Can't decompose an empty matrix");
+
+    // The bidiagonalization needs a tall matrix, a wide one is decomposed
+    // through its transpose with the roles of u and v swapped.
+    const bool wide = rows_ < cols_;
+    const int32_t m = wide ? cols_ : rows_;
+    const int32_t n = wide ? rows_ : cols_;
+
+    ColMajor a(m, n);
+    for (int32_t i = 0; i < rows_; ++i)
+        for (int32_t j = 0; j < cols_; ++j)
+            if (wide)
+                a(j, i) = matrix_[i * cols_ + j];
+            else
+                a(i, j) = matrix_[i * cols_ + j];
+
+    std::vector<double> s(n);
+    std::vector<double> e(n);
+    std::vector<double> tauq(n);
+    std::vector<double> taup(n);
+    bidiagonalize(a, m, n, s.data(), e.data(), tauq.data(), taup.data());
+
+    // The reflectors are multiplied out into the m x n U and the n x n V,
+    // block p only touches rows and columns from p on. QR then rotates them
+    // into the singular vectors.
+    ColMajor uf(m, n);
+    ColMajor vf(n, n);
+    for (int32_t i = 0; i < n; ++i)
+        uf(i, i) = vf(i, i) = 1.0;
+    for (int32_t p = (n - 1) / kPanel * kPanel; p >= 0; p -= kPanel) {
+        const int32_t nb = std::min(kPanel, n - p);
+        std::vector<double> blk = reflector_block(&a(p, p), 1, m, m - p, nb);
+        apply_block(m - p, nb, blk.data(), &tauq[p], &uf(p, p), m, n - p);
+    }
+    for (int32_t p = (n - 2) / kPanel * kPanel; p >= 0 && n > 1; p -= kPanel) {
+        const int32_t nb = std::min(kPanel, n - 1 - p);
+        std::vector<double> blk =
+            reflector_block(&a(p, p + 1), m, 1, n - 1 - p, nb);
+        apply_block(n - 1 - p, nb, blk.data(), &taup[p], &vf(p + 1, p + 1), n,
+                    n - 1 - p);
+    }
+    {
+        RotationQueue uq(uf, m);
+        RotationQueue vq(vf, n);
+        bidiagonal_qr(s, e, uq, vq, n);
+    }
+
+    S21Matrix left(m, n, uninit);
+    S21Matrix right(n, n, uninit);
+    S21Matrix sv(n, 1, uninit);
+    for (int32_t j = 0; j < n; ++j) {
+        sv.matrix_[j] = s[j];
+        for (int32_t i = 0; i < m; ++i)
+            left.matrix_[i * n + j] = uf(i, j);
+        for (int32_t i = 0; i < n; ++i)
+            right.matrix_[i * n + j] = vf(i, j);
+    }
+
+    sigma = std::move(sv);
+    if (wide) {
+        u = std::move(right);
+        v = std::move(left);
+    } else {
+        u = std::move(left);
+        v = std::move(right);
+    }
+}
@@ -0,0 +1,325 @@
+#include "s21_matrix_expr.hpp"
+
+#include <limits>
+
+#include "s21_trace.hpp"
+
+namespace s21 {
+
+struct Expr::Node {
+    enum class Kind { kLeaf, kTranspose, kScale, kProduct, kSum, kKronecker };
+
+    Kind kind;
+    int32_t rows, cols;
+    const S21Matrix *leaf;
+    std::shared_ptr<const S21Matrix> owned;
+    double scale;
+    std::vector<std::shared_ptr<const Node>> children;
+};
+
+namespace {
+
+using Node = Expr::Node;
+using Kind = Expr::Node::Kind;
+using NodePtr = std::shared_ptr<const Node>;
+
+NodePtr make_node(Kind kind, int32_t rows, int32_t cols,
+                  std::vector<NodePtr> children, double scale = 1.0) {
+    return std::make_shared<const Node>(
+        Node{kind, rows, cols, nullptr, nullptr, scale, std::move(children)});
+}
+
+// Operand of a GEMM call: a matrix read as is or transposed. Intermediate
+// results are owned by the operand that refers to them.
+struct Operand {
+    const S21Matrix *matrix;
+    bool trans;
+    std::shared_ptr<const S21Matrix> owned;
+
+    int32_t rows() const {
+        return trans ? matrix->get_cols() : matrix->get_rows();
+    }
+    int32_t cols() const {
+        return trans ? matrix->get_rows() : matrix->get_cols();
+    }
+};
+
+// alpha * factors[0] * factors[1] * ...
+struct Term {
+    double alpha;
+    std::vector<Operand> factors;
+};
+
+S21Matrix evaluate(const NodePtr &node, bool trans);
+void flatten(const NodePtr &node, bool trans, Term &term);
+
+// A single operand for the node, leaves are referenced without a copy.
+Operand resolve(const NodePtr &node, bool trans) {
+    Term term{1.0, {}};
+    flatten(node, trans, term);
+    if (term.alpha == 1.0 && term.factors.size() == 1)
+        return term.factors[0];
+
+    auto res = std::make_shared<const S21Matrix>(evaluate(node, trans));
+    return {res.get(), false, res};
+}
+
+// (A (x) B) X, column j of X read as an n x q matrix X_j turns into the
+// m x p matrix A X_j B^T.
+std::shared_ptr<const S21Matrix> kronecker_apply(const NodePtr &kron,
+                                                 const NodePtr &rhs) {
+    Operand a = resolve(kron->children[0], false);
+    Operand b = resolve(kron->children[1], false);
+    Operand x = resolve(rhs, false);
+
+    const int32_t m = a.rows(), n = a.cols(), p = b.rows(), q = b.cols();
+    const int32_t cols = x.cols();
+    auto res = std::make_shared<S21Matrix>(m * p, cols, S21Matrix::uninit);
+    S21Matrix xj(n, q, S21Matrix::uninit);
+    S21Matrix tmp(n, p, S21Matrix::uninit);
+    S21Matrix yj(m, p, S21Matrix::uninit);
+    for (int32_t j = 0; j < cols; ++j) {
+        for (int32_t r = 0; r < n * q; ++r)
+            xj[r / q][r % q] = x.trans ? (*x.matrix)[j][r] : (*x.matrix)[r][j];
+
+        S21Matrix::Gemm(1.0, xj, false, *b.matrix, !b.trans, 0.0, tmp);
+        S21Matrix::Gemm(1.0, *a.matrix, a.trans, tmp, false, 0.0, yj);
+
+        for (int32_t r = 0; r < m * p; ++r)
+            (*res)[r][j] = yj[r / p][r % p];
+    }
+    return res;
+}
+
+void flatten(const NodePtr &node, bool trans, Term &term) {
+    switch (node->kind) {
+        case Kind::kLeaf:
+            term.factors.push_back({node->leaf, trans, nullptr});
+            break;
+        case Kind::kTranspose:
+            flatten(node->children[0], !trans, term);
+            break;
+        case Kind::kScale:
+            term.alpha *= node->scale;
+            flatten(node->children[0], trans, term);
+            break;
+        case Kind::kProduct: {
+            double scale = 1.0;
+            NodePtr lhs = node->children[0];
+            for (; lhs->kind == Kind::kScale; lhs = lhs->children[0])
+                scale *= lhs->scale;
+            if (lhs->kind == Kind::kKronecker) {
+                auto res = kronecker_apply(lhs, node->children[1]);
+                term.alpha *= scale;
+                term.factors.push_back({res.get(), trans, res});
+                break;
+            }
+            // (A B)^T = B^T A^T
+            flatten(node->children[trans ? 1 : 0], trans, term);
+            flatten(node->children[trans ? 0 : 1], trans, term);
+            break;
+        }
+        case Kind::kSum: {
+            auto sum = std::make_shared<const S21Matrix>(evaluate(node, trans));
+            term.factors.push_back({sum.get(), false, sum});
+            break;
+        }
+        case Kind::kKronecker: {
+            Operand a = resolve(node->children[0], false);
+            Operand b = resolve(node->children[1], false);
+            S21Matrix lhs = a.trans ? a.matrix->Transpose() : *a.matrix;
+            S21Matrix rhs = b.trans ? b.matrix->Transpose() : *b.matrix;
+            auto res = std::make_shared<const S21Matrix>(lhs.Kronecker(rhs));
+            term.factors.push_back({res.get(), trans, res});
+            break;
+        }
+    }
+}
+
+void collect(const NodePtr &node, bool trans, double alpha,
+             std::vector<Term> &terms) {
+    switch (node->kind) {
+        case Kind::kSum:
+            collect(node->children[0], trans, alpha, terms);
+            collect(node->children[1], trans, alpha, terms);
+            break;
+        case Kind::kScale:
+            collect(node->children[0], trans, alpha * node->scale, terms);
+            break;
+        case Kind::kTranspose:
+            collect(node->children[0], !trans, alpha, terms);
+            break;
+        default: {
+            Term term{alpha, {}};
+            flatten(node, trans, term);
+            terms.push_back(std::move(term));
+        }
+    }
+}
+
+// Classic matrix chain ordering, split[i][j] is where the product of the
+// factors i..j is divided.
+std::vector<std::vector<size_t>> chain_order(const std::vector<Operand> &f) {
+    const size_t n = f.size();
+    std::vector<double> dims(n + 1);
+    dims[0] = f[0].rows();
+    for (size_t i = 0; i < n; ++i)
+        dims[i + 1] = f[i].cols();
+
+    std::vector<std::vector<double>> cost(n, std::vector<double>(n, 0.0));
+    std::vector<std::vector<size_t>> split(n, std::vector<size_t>(n, 0));
+    for (size_t len = 2; len <= n; ++len) {
+        for (size_t i = 0; i + len <= n; ++i) {
+            const size_t j = i + len - 1;
+            cost[i][j] = std::numeric_limits<double>::infinity();
+            for (size_t s = i; s < j; ++s) {
+                double c = cost[i][s] + cost[s + 1][j] +
+                           dims[i] * dims[s + 1] * dims[j + 1];
+                if (c < cost[i][j]) {
+                    cost[i][j] = c;
+                    split[i][j] = s;
+                }
+            }
+        }
+    }
+    return split;
+}
+
+Operand multiply(const std::vector<Operand> &f,
+                 const std::vector<std::vector<size_t>> &split, size_t i,
+                 size_t j) {
+    if (i == j)
+        return f[i];
+
+    const size_t s = split[i][j];
+    Operand lhs = multiply(f, split, i, s);
+    Operand rhs = multiply(f, split, s + 1, j);
+    auto res = std::make_shared<S21Matrix>(lhs.rows(), rhs.cols(),
+                                           S21Matrix::uninit);
+    S21Matrix::Gemm(1.0, *lhs.matrix, lhs.trans, *rhs.matrix, rhs.trans, 0.0,
+                    *res);
+
+    return {res.get(), false, res};
+}
+
+// dest = alpha * op(src) + beta * dest
+void accumulate(double alpha, const Operand &src, double beta,
+                S21Matrix &dest) {
+    const int32_t rows = src.matrix->get_rows();
+    const int32_t cols = src.matrix->get_cols();
+    for (int32_t i = 0; i < rows; ++i) {
+        const double *row = (*src.matrix)[i];
+        for (int32_t j = 0; j < cols; ++j) {
+            double &out = src.trans ? dest[j][i] : dest[i][j];
+            out = (beta == 0.0 ? 0.0 : beta * out) + alpha * row[j];
+        }
+    }
+}
+
+void accumulate(const Term &term, double beta, S21Matrix &dest) {
+    const std::vector<Operand> &f = term.factors;
+    if (f.size() == 1) {
+        accumulate(term.alpha, f[0], beta, dest);
+        return;
+    }
+
+    // The outermost product is written straight into the destination with
+    // the folded scale, only the inner ones need temporaries.
+    auto split = chain_order(f);
+    const size_t s = split[0][f.size() - 1];
+    Operand lhs = multiply(f, split, 0, s);
+    Operand rhs = multiply(f, split, s + 1, f.size() - 1);
+    S21Matrix::Gemm(term.alpha, *lhs.matrix, lhs.trans, *rhs.matrix, rhs.trans,
+                    beta, dest);
+}
+
+S21Matrix evaluate(const NodePtr &node, bool trans) {
+    std::vector<Term> terms;
+    collect(node, trans, 1.0, terms);
+
+    S21Matrix res(trans ? node->cols : node->rows,
+                  trans ? node->rows : node->cols, S21Matrix::uninit);
+    for (size_t i = 0; i < terms.size(); ++i)
+        accumulate(terms[i], i == 0 ? 0.0 : 1.0, res);
+
+    return res;
+}
+
+}  // namespace
+
+Expr::Expr(std::shared_ptr<const Node> node) : node_(std::move(node)) {
+}
+
+Expr::Expr(const S21Matrix &leaf)
+    : node_(std::make_shared<const Node>(Node{Kind::kLeaf, leaf.get_rows(),
+                                              leaf.get_cols(), &leaf, nullptr,
+                                              1.0, {}})) {
+}
+
+Expr::Expr(S21Matrix &&leaf) {
+    auto owned = std::make_shared<const S21Matrix>(std::move(leaf));
+    node_ = std::make_shared<const Node>(Node{Kind::kLeaf, owned->get_rows(),
+                                              owned->get_cols(), owned.get(),
+                                              owned, 1.0, {}});
+}
+
+int32_t Expr::get_rows() const noexcept {
+    return node_->rows;
+}
+
+int32_t Expr::get_cols() const noexcept {
+    return node_->cols;
+}
+
+Expr Expr::Transpose() const {
+    return Expr(make_node(Kind::kTranspose, node_->cols, node_->rows, {node_}));
+}
+
+S21Matrix Expr::Eval() const {
+    S21_TRACE_SCOPE("Expr::Eval", node_->rows, node_->cols);
+    return evaluate(node_, false);
+}
+
+Expr operator*(const Expr &lhs, const Expr &rhs) {
+    if (lhs.get_cols() != rhs.get_rows())
+        throw std::logic_error("Dimensions don't fit for the multiplication");
+
+    return Expr(make_node(Kind::kProduct, lhs.get_rows(), rhs.get_cols(),
+                          {lhs.node_, rhs.node_}));
+}
+
+Expr operator*(const Expr &expr, double value) {
+    return Expr(make_node(Kind::kScale, expr.get_rows(), expr.get_cols(),
+                          {expr.node_}, value));
+}
+
+Expr operator*(double value, const Expr &expr) {
+    return expr * value;
+}
+
+Expr operator+(const Expr &lhs, const Expr &rhs) {
+    if (lhs.get_rows() != rhs.get_rows() || lhs.get_cols() != rhs.get_cols())
+        throw std::logic_error("Can't sum matrices of different dimensions");
+
+    return Expr(make_node(Kind::kSum, lhs.get_rows(), lhs.get_cols(),
+                          {lhs.node_, rhs.node_}));
+}
+
+Expr operator-(const Expr &lhs, const Expr &rhs) {
+    return lhs + rhs * -1.0;
+}
+
+Expr Kronecker(const Expr &lhs, const Expr &rhs) {
+    return Expr(make_node(Kind::kKronecker, lhs.get_rows() * rhs.get_rows(),
+                          lhs.get_cols() * rhs.get_cols(), {lhs.node_, rhs.node_}));
+}
+
+}  // namespace s21
+
+s21::Expr S21Matrix::Lazy() const & {
+    return s21::Expr(*this);
+}
+
+s21::Expr S21Matrix::Lazy() && {
+    return s21::Expr(std::move(*this));
+}
@@ -0,0 +1,54 @@
+#ifndef SRC_S21_MATRIX_EXPR_H_
+#define SRC_S21_MATRIX_EXPR_H_
+
+#include <memory>
+#include <vector>
+
+#include "s21_matrix_oop.hpp"
+
+namespace s21 {
+
+// Deferred matrix expression. Operations only record a graph, Eval()
+// simplifies it and computes the result:
+//  - nested transposes cancel and are pushed down to the leaves, where
+//    they become transpose flags of the GEMM operands,
+//  - scalar factors are folded into the GEMM alpha,
+//  - products are flattened into chains and multiplied in the order with
+//    the fewest flops,
+//  - the terms of a sum accumulate straight into the result,
+//  - a Kronecker product times a matrix, (A (x) B) X, is computed column by
+//    column as A X_j B^T without forming A (x) B.
+// Leaves built from an lvalue are referenced, not copied, and have to
+// outlive the expression.
+class Expr {
+  public:
+    struct Node;
+
+  private:
+    std::shared_ptr<const Node> node_;
+
+    explicit Expr(std::shared_ptr<const Node> node);
+
+  public:
+    explicit Expr(const S21Matrix &leaf);
+    explicit Expr(S21Matrix &&leaf);
+
+    int32_t get_rows() const noexcept;
+    int32_t get_cols() const noexcept;
+
+    Expr Transpose() const;
+    S21Matrix Eval() const;
+
+    friend Expr operator*(const Expr &lhs, const Expr &rhs);
+    friend Expr operator*(const Expr &expr, double value);
+    friend Expr operator*(double value, const Expr &expr);
+    friend Expr operator+(const Expr &lhs, const Expr &rhs);
+    friend Expr operator-(const Expr &lhs, const Expr &rhs);
+    friend Expr Kronecker(const Expr &lhs, const Expr &rhs);
+};
+
+Expr Kronecker(const Expr &lhs, const Expr &rhs);
+
+}  // namespace s21
+
+#endif  // SRC_S21_MATRIX_EXPR_H_
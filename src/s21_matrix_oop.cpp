@@ -1,5 +1,61 @@
 #include "s21_matrix_oop.hpp"
 
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+#include "s21_kernels.hpp"
+#include "s21_numa.hpp"
+#include "s21_parallel.hpp"
+#include "s21_trace.hpp"
+
+namespace {
+
+// Runs body(first_row, last_row) over row ranges big enough to be worth a
+// thread each.
+void for_rows(int32_t rows, int32_t cols,
+              const std::function<void(int32_t, int32_t)> &body) {
+    s21::parallel_for(rows, std::max<int64_t>(1, s21::parallel_cutoff() / cols),
+                      [&](int64_t begin, int64_t end) {
+                          body(static_cast<int32_t>(begin),
+                               static_cast<int32_t>(end));
+                      });
+}
+
+// Under kFirstTouch a page goes to the node of the thread that writes it
+// first. Buffers written through for_rows put every row range on the node
+// of the worker that later row-wise operations hand the same range to.
+void copy_rows(const double *src, int32_t rows, int32_t cols, double *dst) {
+    if (rows <= 0 || cols <= 0)
+        return;
+
+    for_rows(rows, cols, [&](int32_t first, int32_t last) {
+        const ptrdiff_t begin = static_cast<ptrdiff_t>(first) * cols;
+        std::copy(src + begin, src + static_cast<ptrdiff_t>(last) * cols,
+                  dst + begin);
+    });
+}
+
+// Fresh large mappings are already zero, they are only written on machines
+// where placing the pages pays off.
+void place_zero_rows(double *data, int32_t rows, int32_t cols) {
+    if (static_cast<int64_t>(rows) * cols < s21::kLargeAllocation ||
+        s21::numa_node_count() < 2 ||
+        s21::get_numa_policy() != s21::NumaPolicy::kFirstTouch)
+        return;
+
+    for_rows(rows, cols, [&](int32_t first, int32_t last) {
+        std::fill(data + static_cast<ptrdiff_t>(first) * cols,
+                  data + static_cast<ptrdiff_t>(last) * cols, 0.0);
+    });
+}
+
+}  // namespace
+
 S21Matrix::S21Matrix() : rows_(0), cols_(0), matrix_(nullptr) {
 }
 
@@ -7,19 +63,27 @@ S21Matrix::S21Matrix(int32_t rows, int32_t cols) : rows_(rows), cols_(cols) {
     if (rows_ <= 0 || cols_ <= 0)
         throw std::length_error("Array size can't be zero");
 
-    matrix_ = new double[rows_ * cols_]();
+    matrix_ = s21::allocate(static_cast<int64_t>(rows_) * cols_);
+    place_zero_rows(matrix_, rows_, cols_);
+}
+
+S21Matrix::S21Matrix(int32_t rows, int32_t cols, Uninit)
+    : rows_(rows), cols_(cols) {
+    if (rows_ <= 0 || cols_ <= 0)
+        throw std::length_error("Array size can't be zero");
+
+    matrix_ = s21::allocate(static_cast<int64_t>(rows_) * cols_, false);
 }
 
 S21Matrix::~S21Matrix() {
-    delete[] matrix_;
+    s21::deallocate(matrix_, static_cast<int64_t>(rows_) * cols_);
     matrix_ = nullptr;
 }
 
 S21Matrix::S21Matrix(const S21Matrix &other)
     : rows_(other.rows_), cols_(other.cols_),
-      matrix_(new double[rows_ * cols_]()) {
-
-    std::copy(other.matrix_, other.matrix_ + rows_ * cols_, matrix_);
+      matrix_(s21::allocate(static_cast<int64_t>(rows_) * cols_, false)) {
+    copy_rows(other.matrix_, rows_, cols_, matrix_);
 }
 
 S21Matrix::S21Matrix(S21Matrix &&other) noexcept {
@@ -86,31 +150,157 @@ void S21Matrix::set_cols(const int32_t &new_cols) {
 
 S21Matrix &S21Matrix::operator=(const S21Matrix &other) {
     if (this != &other) {
-        delete[] matrix_;
+        s21::deallocate(matrix_, static_cast<int64_t>(rows_) * cols_);
+        matrix_ = nullptr;
 
         rows_ = other.rows_;
         cols_ = other.cols_;
 
-        matrix_ = new double[rows_ * cols_]();
-        std::copy(other.matrix_, other.matrix_ + rows_ * cols_, matrix_);
+        matrix_ = s21::allocate(static_cast<int64_t>(rows_) * cols_, false);
+        copy_rows(other.matrix_, rows_, cols_, matrix_);
     }
     return *this;
 }
 
-bool S21Matrix::operator==(const S21Matrix &other) const noexcept {
+bool S21Matrix::operator==(const S21Matrix &other) const {
     return EqMatrix(other);
 }
 
-bool S21Matrix::EqMatrix(const S21Matrix &other) const {
+namespace {
+
+constexpr int64_t kCompareChunk = 1024;
+
+// Maps a double onto an integer line where adjacent doubles differ by one.
+int64_t ordered_bits(double x) {
+    int64_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    return bits < 0 ? std::numeric_limits<int64_t>::min() - bits : bits;
+}
+
+double ulp_distance(double a, double b) {
+    if (std::isnan(a) || std::isnan(b))
+        return std::numeric_limits<double>::infinity();
+
+    int64_t x = ordered_bits(a), y = ordered_bits(b);
+    return static_cast<double>(x > y ? static_cast<uint64_t>(x) - y
+                                     : static_cast<uint64_t>(y) - x);
+}
+
+double relative_error(double a, double b) {
+    double scale = std::max(std::fabs(a), std::fabs(b));
+    return scale == 0.0 ? 0.0 : std::fabs(a - b) / scale;
+}
+
+double element_error(double a, double b, S21Matrix::Compare mode) {
+    switch (mode) {
+        case S21Matrix::Compare::kRelative:
+            return a == b ? 0.0 : relative_error(a, b);
+        case S21Matrix::Compare::kUlp:
+            return ulp_distance(a, b);
+        case S21Matrix::Compare::kBitwise:
+            return std::memcmp(&a, &b, sizeof(a)) == 0 ? 0.0 : 1.0;
+        default:
+            return a == b ? 0.0 : std::fabs(a - b);
+    }
+}
+
+// Branch-free pass over one chunk so the loop vectorizes, the caller exits
+// early between chunks. NaN compares unequal in every mode, infinities of
+// the same sign compare equal.
+bool chunk_equal(const double *a, const double *b, int64_t n,
+                 S21Matrix::Compare mode, double tolerance) {
+    bool bad = false;
+    switch (mode) {
+        case S21Matrix::Compare::kAbsolute:
+            for (int64_t i = 0; i < n; ++i)
+                bad |= !(a[i] == b[i] || std::fabs(a[i] - b[i]) <= tolerance);
+            break;
+        case S21Matrix::Compare::kRelative:
+            for (int64_t i = 0; i < n; ++i)
+                bad |= !(a[i] == b[i] ||
+                         std::fabs(a[i] - b[i]) <=
+                             tolerance * std::max(std::fabs(a[i]), std::fabs(b[i])));
+            break;
+        case S21Matrix::Compare::kUlp:
+            for (int64_t i = 0; i < n; ++i)
+                bad |= !(ulp_distance(a[i], b[i]) <= tolerance);
+            break;
+        case S21Matrix::Compare::kBitwise:
+            bad = std::memcmp(a, b, n * sizeof(double)) != 0;
+            break;
+    }
+    return !bad;
+}
+
+}  // namespace
+
+bool S21Matrix::EqMatrix(const S21Matrix &other, Compare mode,
+                         double tolerance) const {
     if (rows_ != other.get_rows() || cols_ != other.get_cols())
         return false;
 
-    for (int32_t i = 0; i < rows_; ++i)
-        for (int32_t j = 0; j < cols_; ++j)
-            if (std::fabs((*this)[i][j] - other[i][j]) > 1e-07)
-                return false;
+    // The first chunk is checked before the span opens, a mismatch there
+    // takes less time than recording it would.
+    const int64_t size = static_cast<int64_t>(rows_) * cols_;
+    const int64_t head = std::min(kCompareChunk, size);
+    if (!chunk_equal(matrix_, other.matrix_, head, mode, tolerance))
+        return false;
+    if (head == size)
+        return true;
+
+    S21_TRACE_SCOPE("EqMatrix", rows_, cols_);
+    const double *lhs = matrix_ + head;
+    const double *rhs = other.matrix_ + head;
+    std::atomic<bool> equal{true};
+    s21::parallel_for(
+        size - head, s21::parallel_cutoff(), [&](int64_t begin, int64_t end) {
+            for (int64_t i = begin; i < end && equal.load(std::memory_order_relaxed);
+                 i += kCompareChunk) {
+                int64_t n = std::min(kCompareChunk, end - i);
+                if (!chunk_equal(lhs + i, rhs + i, n, mode, tolerance))
+                    equal.store(false, std::memory_order_relaxed);
+            }
+        });
 
-    return true;
+    return equal;
+}
+
+S21Matrix::DiffResult S21Matrix::Diff(const S21Matrix &other,
+                                      Compare mode) const {
+    S21_TRACE_SCOPE("Diff", rows_, cols_);
+    if (rows_ != other.get_rows() || cols_ != other.get_cols())
+        throw std::logic_error("Can't diff matrices of different dimensions");
+
+    // Ties keep the first location so the result doesn't depend on how the
+    // range was split between threads.
+    int64_t worst = 0;
+    double max_error = 0.0;
+    std::mutex merge;
+    s21::parallel_for(
+        static_cast<int64_t>(rows_) * cols_, s21::parallel_cutoff(),
+        [&](int64_t begin, int64_t end) {
+            int64_t local_worst = begin;
+            double local_max = 0.0;
+            for (int64_t i = begin; i < end; ++i) {
+                double err = element_error(matrix_[i], other.matrix_[i], mode);
+                if (std::isnan(err))
+                    err = std::numeric_limits<double>::infinity();
+                if (err > local_max) {
+                    local_max = err;
+                    local_worst = i;
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(merge);
+            if (local_max > max_error ||
+                (local_max == max_error && local_worst < worst && local_max > 0)) {
+                max_error = local_max;
+                worst = local_worst;
+            }
+        });
+
+    return {max_error, static_cast<int32_t>(worst / std::max(cols_, 1)),
+            static_cast<int32_t>(worst % std::max(cols_, 1))};
 }
 
 S21Matrix &S21Matrix::operator+=(const S21Matrix &other) {
@@ -124,6 +314,7 @@ S21Matrix S21Matrix::operator+(const S21Matrix &other) const {
 }
 
 void S21Matrix::SumMatrix(const S21Matrix &other) {
+    S21_TRACE_SCOPE("SumMatrix", rows_, cols_);
     if (rows_ != other.get_rows() || cols_ != other.get_cols())
         throw std::logic_error("Can't sum matrices of different dimensions");
 
@@ -145,6 +336,7 @@ S21Matrix S21Matrix::operator-(const S21Matrix &other) const {
 }
 
 void S21Matrix::SubMatrix(const S21Matrix &other) {
+    S21_TRACE_SCOPE("SubMatrix", rows_, cols_);
     if (rows_ != other.get_rows() || cols_ != other.get_cols())
         throw std::logic_error(
             "Can't subtract matrices of different dimensions");
@@ -154,6 +346,30 @@ void S21Matrix::SubMatrix(const S21Matrix &other) {
             (*this)[i][j] -= other[i][j];
 }
 
+namespace {
+
+// Skinny shapes go to the bandwidth-bound matrix-vector and outer-product
+// kernels. Only the rank-1 update accumulates, every other path overwrites
+// the result and doesn't need it zeroed first.
+S21Matrix multiply(const S21Matrix &a, const S21Matrix &b) {
+    if (a.get_cols() == 1 && a.get_rows() != 1 && b.get_cols() != 1) {
+        S21Matrix res(a.get_rows(), b.get_cols());
+        S21Matrix::Ger(1.0, a, b, res);
+        return res;
+    }
+
+    S21Matrix res(a.get_rows(), b.get_cols(), S21Matrix::uninit);
+    if (b.get_cols() == 1)
+        S21Matrix::Gemv(1.0, a, false, b, 0.0, res);
+    else if (a.get_rows() == 1)
+        S21Matrix::Gemv(1.0, b, true, a, 0.0, res);
+    else
+        S21Matrix::Gemm(1.0, a, false, b, false, 0.0, res);
+    return res;
+}
+
+}  // namespace
+
 S21Matrix &S21Matrix::operator*=(const S21Matrix &other) {
     MulMatrix(other);
     return *this;
@@ -165,10 +381,11 @@ S21Matrix &S21Matrix::operator*=(const double &value) {
 }
 
 S21Matrix S21Matrix::operator*(const S21Matrix &other) const {
-    S21Matrix res{*this};
-    res.MulMatrix(other);
+    S21_TRACE_SCOPE("operator*", rows_, cols_);
+    if (cols_ != other.get_rows())
+        throw std::logic_error("Dimensions don't fit for the multiplication");
 
-    return res;
+    return multiply(*this, other);
 }
 
 S21Matrix S21Matrix::operator*(const double &value) const {
@@ -184,128 +401,744 @@ S21Matrix operator*(const double &value, const S21Matrix &matrix) {
 }
 
 void S21Matrix::MulNumber(const double num) {
+    S21_TRACE_SCOPE("MulNumber", rows_, cols_);
     for (int32_t i = 0; i < rows_; ++i)
         for (int32_t j = 0; j < cols_; ++j)
             (*this)[i][j] *= num;
 }
 
-void S21Matrix::MulMatrix(const S21Matrix &other) {
-    if (cols_ != other.get_rows() || rows_ != other.get_cols())
-        throw std::logic_error("Dimensions don't fit for the multiplication");
 
-    S21Matrix res(this->rows_, other.get_cols());
+void S21Matrix::Hadamard(const S21Matrix &other) {
+    S21_TRACE_SCOPE("Hadamard", rows_, cols_);
+    if (rows_ != other.get_rows() || cols_ != other.get_cols())
+        throw std::logic_error(
+            "Can't multiply elementwise matrices of different dimensions");
+
+    for_rows(rows_, cols_, [&](int32_t first, int32_t last) {
+        double *dst = matrix_ + static_cast<ptrdiff_t>(first) * cols_;
+        const double *src = other.matrix_ + static_cast<ptrdiff_t>(first) * cols_;
+        for (int64_t i = 0, n = static_cast<int64_t>(last - first) * cols_; i < n;
+             ++i)
+            dst[i] *= src[i];
+    });
+}
 
-    for (int32_t i = 0; i < rows_; ++i)
-        for (int32_t j = 0; j < other.get_cols(); ++j)
-            for (int32_t k = 0; k < cols_; k++)
-                res[i][j] += (*this)[i][k] * other[k][j];
+namespace {
 
-    *this = std::move(res);
+enum class Broadcast { kAdd, kMul };
+
+// A 1 x cols vector is applied to every row, a rows x 1 vector to every
+// column.
+void broadcast(double *data, int32_t rows, int32_t cols, const double *vec,
+               bool row_vector, Broadcast op) {
+    for_rows(rows, cols, [&](int32_t first, int32_t last) {
+        for (int32_t i = first; i < last; ++i) {
+            double *row = data + static_cast<ptrdiff_t>(i) * cols;
+            if (row_vector && op == Broadcast::kAdd)
+                for (int32_t j = 0; j < cols; ++j)
+                    row[j] += vec[j];
+            else if (row_vector)
+                for (int32_t j = 0; j < cols; ++j)
+                    row[j] *= vec[j];
+            else if (op == Broadcast::kAdd)
+                for (int32_t j = 0; j < cols; ++j)
+                    row[j] += vec[i];
+            else
+                for (int32_t j = 0; j < cols; ++j)
+                    row[j] *= vec[i];
+        }
+    });
 }
 
-S21Matrix S21Matrix::Transpose() const {
-    S21Matrix res(cols_, rows_);
+}  // namespace
 
-    for (int32_t i = 0; i < rows_; ++i)
-        for (int32_t j = 0; j < cols_; ++j)
-            res[j][i] = (*this)[i][j];
+void S21Matrix::BroadcastAdd(const S21Matrix &vector) {
+    S21_TRACE_SCOPE("BroadcastAdd", rows_, cols_);
+    const bool row_vector = vector.rows_ == 1 && vector.cols_ == cols_;
+    if (!row_vector && !(vector.cols_ == 1 && vector.rows_ == rows_))
+        throw std::logic_error("The vector doesn't fit for the broadcast");
+
+    broadcast(matrix_, rows_, cols_, vector.matrix_, row_vector,
+              Broadcast::kAdd);
+}
+
+void S21Matrix::BroadcastMul(const S21Matrix &vector) {
+    S21_TRACE_SCOPE("BroadcastMul", rows_, cols_);
+    const bool row_vector = vector.rows_ == 1 && vector.cols_ == cols_;
+    if (!row_vector && !(vector.cols_ == 1 && vector.rows_ == rows_))
+        throw std::logic_error("The vector doesn't fit for the broadcast");
+
+    broadcast(matrix_, rows_, cols_, vector.matrix_, row_vector,
+              Broadcast::kMul);
+}
+
+S21Matrix S21Matrix::Kronecker(const S21Matrix &other) const {
+    S21_TRACE_SCOPE("Kronecker", rows_, cols_);
+    const int32_t p = other.rows_, q = other.cols_;
+    S21Matrix res(rows_ * p, cols_ * q, uninit);
+
+    // Row i * p + k of the result is row i of this scaling row k of other,
+    // block after block.
+    for_rows(res.rows_, res.cols_, [&](int32_t first, int32_t last) {
+        for (int32_t r = first; r < last; ++r) {
+            const double *a = matrix_ + static_cast<ptrdiff_t>(r / p) * cols_;
+            const double *b = other.matrix_ + static_cast<ptrdiff_t>(r % p) * q;
+            double *dst = res.matrix_ + static_cast<ptrdiff_t>(r) * res.cols_;
+            for (int32_t j = 0; j < cols_; ++j)
+                for (int32_t l = 0; l < q; ++l)
+                    dst[j * q + l] = a[j] * b[l];
+        }
+    });
 
     return res;
 }
 
 namespace {
 
-void get_cofactor(const S21Matrix &m, S21Matrix &tmp, int32_t skip_row,
-                  int32_t skip_col, int32_t size) {
-    for (int32_t i = 0, row = 0; row < size; row++) {
-        for (int32_t j = 0, col = 0; col < size; col++) {
-            if (row != skip_row && col != skip_col) {
-                tmp[i][j] = m[row][col];
-                ++j;
-                if (j == size - 1) {
-                    j = 0;
-                    ++i;
+// Partial results of chunk(first, last) over pieces of [0, n) whose size
+// doesn't depend on the thread count, so merging them in index order gives
+// the same answer on any machine. Every index stands for width elements.
+template <typename T, typename Chunk>
+std::vector<T> chunk_partials(int64_t n, int64_t chunk_size, int64_t width,
+                              Chunk chunk) {
+    const int64_t chunks = (n + chunk_size - 1) / chunk_size;
+    std::vector<T> partial(chunks);
+    s21::parallel_for(chunks,
+                      std::max<int64_t>(
+                          1, s21::parallel_cutoff() / (chunk_size * width)),
+                      [&](int64_t first, int64_t last) {
+                          for (int64_t c = first; c < last; ++c)
+                              partial[c] = chunk(c * chunk_size,
+                                                 std::min(n, (c + 1) * chunk_size));
+                      });
+    return partial;
+}
+
+double sum_of(const double *data, int64_t n, bool absolute) {
+    auto partial = chunk_partials<double>(
+        n, s21::kernel::kReduceChunk, 1, [&](int64_t first, int64_t last) {
+            if (!absolute)
+                return s21::kernel::pairwise_sum(data + first, last - first);
+            double buf[s21::kernel::kReduceChunk];
+            for (int64_t i = first; i < last; ++i)
+                buf[i - first] = std::fabs(data[i]);
+            return s21::kernel::pairwise_sum(buf, last - first);
+        });
+    return s21::kernel::pairwise_sum(partial.data(),
+                                     static_cast<int64_t>(partial.size()));
+}
+
+// Same split points as kernel::pairwise_sum, so the result equals the
+// pairwise sum of the absolute values without a row-sized buffer.
+double abs_pairwise_sum(const double *x, int64_t n) {
+    if (n <= s21::kernel::kReduceChunk) {
+        double buf[s21::kernel::kReduceChunk];
+        for (int64_t i = 0; i < n; ++i)
+            buf[i] = std::fabs(x[i]);
+        return s21::kernel::pairwise_sum(buf, n);
+    }
+
+    const int64_t half = n / 2 / 8 * 8;
+    return abs_pairwise_sum(x, half) + abs_pairwise_sum(x + half, n - half);
+}
+
+void row_sums(const double *data, int32_t rows, int32_t cols, bool absolute,
+              double *out) {
+    for_rows(rows, cols, [&](int32_t first, int32_t last) {
+        for (int32_t i = first; i < last; ++i) {
+            const double *row = data + static_cast<ptrdiff_t>(i) * cols;
+            out[i] = absolute ? abs_pairwise_sum(row, cols)
+                              : s21::kernel::pairwise_sum(row, cols);
+        }
+    });
+}
+
+// Upper bound on the block sums col_sums keeps between its two passes.
+constexpr int64_t kColSumGroups = 64;
+
+// Adds the rows first..last of data into acc.
+void add_rows(const double *data, int64_t first, int64_t last, int32_t cols,
+              bool absolute, double *acc) {
+    for (int64_t i = first; i < last; ++i) {
+        const double *row = data + i * cols;
+        if (absolute)
+            for (int32_t j = 0; j < cols; ++j)
+                acc[j] += std::fabs(row[j]);
+        else
+            for (int32_t j = 0; j < cols; ++j)
+                acc[j] += row[j];
+    }
+}
+
+// Rows are summed in fixed blocks, the block sums are then added in a
+// binary tree. Aligned power-of-two runs of blocks are subtrees of it, so
+// each run is reduced on its own with a carry stack, one accumulator per
+// level, and at most kColSumGroups run sums are alive at once.
+void col_sums(const double *data, int32_t rows, int32_t cols, bool absolute,
+              double *out) {
+    const int64_t block = std::max<int64_t>(1, s21::kernel::kReduceChunk / cols);
+    const int64_t blocks = (rows + block - 1) / block;
+    int64_t run = 1;
+    int32_t levels = 1;
+    for (; run * kColSumGroups < blocks; run *= 2)
+        ++levels;
+    const int64_t groups = (blocks + run - 1) / run;
+
+    std::vector<double> partial(static_cast<size_t>(groups) * cols);
+    s21::parallel_for(
+        groups, std::max<int64_t>(1, s21::parallel_cutoff() / (run * block * cols)),
+        [&](int64_t first, int64_t last) {
+            std::vector<double> stack(static_cast<size_t>(levels) * cols);
+            std::vector<int64_t> size(levels);
+            for (int64_t g = first; g < last; ++g) {
+                int32_t top = 0;
+                const int64_t end = std::min(blocks, (g + 1) * run);
+                for (int64_t b = g * run; b < end; ++b) {
+                    double *acc = stack.data() + static_cast<size_t>(top) * cols;
+                    std::fill(acc, acc + cols, 0.0);
+                    add_rows(data, b * block, std::min<int64_t>(rows, (b + 1) * block),
+                             cols, absolute, acc);
+                    size[top++] = 1;
+                    while (top > 1 && size[top - 1] == size[top - 2]) {
+                        s21::kernel::axpy(cols, 1.0, acc, acc - cols);
+                        size[top - 2] *= 2;
+                        acc -= cols;
+                        --top;
+                    }
                 }
+                // A short run closes its open subtrees from the right.
+                for (; top > 1; --top)
+                    s21::kernel::axpy(cols, 1.0,
+                                      stack.data() + static_cast<size_t>(top - 1) * cols,
+                                      stack.data() + static_cast<size_t>(top - 2) * cols);
+                std::copy(stack.data(), stack.data() + cols,
+                          partial.data() + g * cols);
             }
+        });
+
+    for (int64_t step = 1; step < groups; step *= 2)
+        for (int64_t g = 0; g + step < groups; g += 2 * step)
+            s21::kernel::axpy(cols, 1.0, partial.data() + (g + step) * cols,
+                              partial.data() + g * cols);
+    std::copy(partial.data(), partial.data() + cols, out);
+}
+
+}  // namespace
+
+double S21Matrix::Sum() const {
+    S21_TRACE_SCOPE("Sum", rows_, cols_);
+    return sum_of(matrix_, static_cast<int64_t>(rows_) * cols_, false);
+}
+
+S21Matrix S21Matrix::RowSums() const {
+    S21_TRACE_SCOPE("RowSums", rows_, cols_);
+    S21Matrix res(rows_, 1, uninit);
+    row_sums(matrix_, rows_, cols_, false, res.matrix_);
+    return res;
+}
+
+S21Matrix S21Matrix::ColSums() const {
+    S21_TRACE_SCOPE("ColSums", rows_, cols_);
+    S21Matrix res(1, cols_, uninit);
+    col_sums(matrix_, rows_, cols_, false, res.matrix_);
+    return res;
+}
+
+double S21Matrix::Trace() const {
+    S21_TRACE_SCOPE("Trace", rows_, cols_);
+    if (rows_ != cols_)
+        throw std::logic_error("The matrix is not square to calculate trace");
+
+    std::vector<double> diagonal(rows_);
+    for (int32_t i = 0; i < rows_; ++i)
+        diagonal[i] = (*this)[i][i];
+    return s21::kernel::pairwise_sum(diagonal.data(), rows_);
+}
+
+double S21Matrix::Norm(NormType type) const {
+    S21_TRACE_SCOPE("Norm", rows_, cols_);
+    if (matrix_ == nullptr)
+        return 0.0;
+
+    std::vector<double> sums;
+    switch (type) {
+        case NormType::kFrobenius: {
+            // Scaled by the largest element so the squares can't overflow.
+            const double scale = Norm(NormType::kMax);
+            if (scale == 0.0 || !std::isfinite(scale))
+                return scale;
+
+            const double *data = matrix_;
+            auto partial = chunk_partials<double>(
+                static_cast<int64_t>(rows_) * cols_, s21::kernel::kReduceChunk, 1,
+                [&](int64_t first, int64_t last) {
+                    double buf[s21::kernel::kReduceChunk];
+                    for (int64_t i = first; i < last; ++i) {
+                        const double x = data[i] / scale;
+                        buf[i - first] = x * x;
+                    }
+                    return s21::kernel::pairwise_sum(buf, last - first);
+                });
+            return scale * std::sqrt(s21::kernel::pairwise_sum(
+                               partial.data(), static_cast<int64_t>(partial.size())));
+        }
+        case NormType::kOne:
+            sums.resize(cols_);
+            col_sums(matrix_, rows_, cols_, true, sums.data());
+            break;
+        case NormType::kInf:
+            sums.resize(rows_);
+            row_sums(matrix_, rows_, cols_, true, sums.data());
+            break;
+        case NormType::kMax: {
+            auto [lo, hi] = MinMax();
+            return std::max(std::fabs(lo), std::fabs(hi));
         }
     }
+    return *std::max_element(sums.begin(), sums.end());
 }
 
-double det(const S21Matrix &m, int32_t size) {
+std::pair<double, double> S21Matrix::MinMax() const {
+    S21_TRACE_SCOPE("MinMax", rows_, cols_);
+    if (matrix_ == nullptr)
+        throw std::length_error("Array size can't be zero");
 
-    double res = 0;
+    const double *data = matrix_;
+    auto partial = chunk_partials<std::pair<double, double>>(
+        static_cast<int64_t>(rows_) * cols_, s21::kernel::kReduceChunk, 1,
+        [&](int64_t first, int64_t last) {
+            double lo = std::numeric_limits<double>::infinity();
+            double hi = -lo;
+            for (int64_t i = first; i < last; ++i) {
+                lo = data[i] < lo ? data[i] : lo;
+                hi = data[i] > hi ? data[i] : hi;
+            }
+            return std::make_pair(lo, hi);
+        });
 
-    if (size == 1)
-        return m[0][0];
+    std::pair<double, double> res = partial[0];
+    for (const auto &[lo, hi] : partial) {
+        res.first = std::min(res.first, lo);
+        res.second = std::max(res.second, hi);
+    }
+    return res;
+}
 
-    S21Matrix tmp(size, size);
+std::pair<int32_t, int32_t> S21Matrix::ArgMax() const {
+    S21_TRACE_SCOPE("ArgMax", rows_, cols_);
+    if (matrix_ == nullptr)
+        throw std::length_error("Array size can't be zero");
 
-    int sign = 1;
-    for (int32_t i = 0; i < size; ++i) {
-        get_cofactor(m, tmp, 0, i, size);
-        res += sign * m[0][i] * det(tmp, size - 1);
-        sign = -sign;
-    }
+    const double *data = matrix_;
+    auto partial = chunk_partials<int64_t>(
+        static_cast<int64_t>(rows_) * cols_, s21::kernel::kReduceChunk, 1,
+        [&](int64_t first, int64_t last) {
+            int64_t best = first;
+            for (int64_t i = first + 1; i < last; ++i)
+                if (data[i] > data[best] || std::isnan(data[best]))
+                    best = i;
+            return best;
+        });
+
+    int64_t best = partial[0];
+    for (int64_t i : partial)
+        if (data[i] > data[best] || std::isnan(data[best]))
+            best = i;
+    return {static_cast<int32_t>(best / cols_),
+            static_cast<int32_t>(best % cols_)};
+}
+
+void S21Matrix::MulMatrix(const S21Matrix &other) {
+    S21_TRACE_SCOPE("MulMatrix", rows_, cols_);
+    if (cols_ != other.get_rows())
+        throw std::logic_error("Dimensions don't fit for the multiplication");
+
+    *this = multiply(*this, other);
+}
+
+void S21Matrix::Gemm(double alpha, const S21Matrix &a, bool trans_a,
+                     const S21Matrix &b, bool trans_b, double beta,
+                     S21Matrix &c) {
+    S21_TRACE_SCOPE("Gemm", c.rows_, c.cols_);
+    const int32_t m = trans_a ? a.cols_ : a.rows_;
+    const int32_t k = trans_a ? a.rows_ : a.cols_;
+    const int32_t n = trans_b ? b.rows_ : b.cols_;
+
+    if ((trans_b ? b.cols_ : b.rows_) != k || c.rows_ != m || c.cols_ != n)
+        throw std::logic_error("Dimensions don't fit for the multiplication");
+    if (&c == &a || &c == &b)
+        throw std::logic_error("The result can't alias an operand");
+
+    s21::kernel::gemm(m, n, k, alpha,
+                      s21::kernel::view(a.matrix_, a.cols_, trans_a),
+                      s21::kernel::view(b.matrix_, b.cols_, trans_b), beta,
+                      c.matrix_, c.cols_);
+}
+
+namespace {
+
+bool is_vector(const S21Matrix &m) {
+    return m.get_rows() == 1 || m.get_cols() == 1;
+}
+
+int32_t length(const S21Matrix &m) {
+    return m.get_rows() * m.get_cols();
+}
+
+}  // namespace
+
+void S21Matrix::Gemv(double alpha, const S21Matrix &a, bool trans_a,
+                     const S21Matrix &x, double beta, S21Matrix &y) {
+    S21_TRACE_SCOPE("Gemv", a.rows_, a.cols_);
+    if (!is_vector(x) || !is_vector(y) ||
+        length(x) != (trans_a ? a.rows_ : a.cols_) ||
+        length(y) != (trans_a ? a.cols_ : a.rows_))
+        throw std::logic_error("Dimensions don't fit for the multiplication");
+    if (&y == &a || &y == &x)
+        throw std::logic_error("The result can't alias an operand");
+
+    s21::kernel::gemv(a.rows_, a.cols_, alpha, a.matrix_, trans_a, x.matrix_,
+                      beta, y.matrix_);
+}
+
+void S21Matrix::Ger(double alpha, const S21Matrix &x, const S21Matrix &y,
+                    S21Matrix &a) {
+    S21_TRACE_SCOPE("Ger", a.rows_, a.cols_);
+    if (!is_vector(x) || !is_vector(y) || length(x) != a.rows_ ||
+        length(y) != a.cols_)
+        throw std::logic_error("Dimensions don't fit for the rank-1 update");
+    if (&a == &x || &a == &y)
+        throw std::logic_error("The result can't alias an operand");
+
+    s21::kernel::ger(a.rows_, a.cols_, alpha, x.matrix_, y.matrix_, a.matrix_);
+}
+
+S21Matrix S21Matrix::Transpose() const {
+    S21_TRACE_SCOPE("Transpose", rows_, cols_);
+    S21Matrix res(cols_, rows_, uninit);
+    s21::kernel::transpose(rows_, cols_, matrix_, res.matrix_);
 
     return res;
 }
 
-S21Matrix adjoint(const S21Matrix &m) {
-    const int32_t rows = m.get_rows();
-    const int32_t cols = m.get_cols();
+namespace {
+
+// Narrowest column range a solve is split into. Every range walks the whole
+// factorization, so thinner ones only add passes over it.
+constexpr int64_t kSolveColumns = 32;
+
+// Factorization shared by the determinant, inverse and complements, which
+// keeps them O(n^3) with a single working copy of the matrix.
+class Lu {
+  public:
+    Lu(const double *data, int32_t size)
+        : size_(size), factors_(data, data + size * size), pivots_(size) {
+        sign_ = s21::kernel::lu(size_, factors_.data(), pivots_.data());
+    }
 
-    if (rows == 1) {
-        m[0][0] = 1;
-        return m;
+    double determinant() const {
+        double det = sign_;
+        for (int32_t i = 0; i < size_; ++i)
+            det *= factors_[i * size_ + i];
+        return det;
     }
 
-    S21Matrix tmp(rows, cols);
-    S21Matrix res(rows, cols);
+    // Pivots that small relative to the largest one make the inverse
+    // meaningless even if none of them is exactly zero.
+    bool well_conditioned() const {
+        double lo = std::numeric_limits<double>::infinity(), hi = 0.0;
+        for (int32_t i = 0; i < size_; ++i) {
+            double pivot = std::fabs(factors_[i * size_ + i]);
+            lo = std::min(lo, pivot);
+            hi = std::max(hi, pivot);
+        }
+        return lo > size_ * std::numeric_limits<double>::epsilon() * hi;
+    }
 
-    for (int32_t i = 0; i < rows; ++i) {
-        for (int32_t j = 0; j < cols; ++j) {
-            get_cofactor(m, tmp, i, j, rows);
+    // Overwrites the row-major size x nrhs buffer b with the solution,
+    // independent column ranges are solved in parallel.
+    void solve(double *b, int32_t nrhs) const {
+        const int64_t n = size_;
+        s21::parallel_for(nrhs,
+                          std::max(kSolveColumns, s21::parallel_cutoff() / (n * n)),
+                          [&](int64_t begin, int64_t end) {
+                              s21::kernel::lu_solve(size_, factors_.data(),
+                                                    pivots_.data(), b + begin,
+                                                    end - begin, nrhs);
+                          });
+    }
 
-            int sign = ((i + j) % 2 == 0) ? 1 : -1;
+    // Writes the inverse into a row-major size x size buffer.
+    void inverse(double *out) const {
+        const int64_t n = size_;
+        std::fill(out, out + n * n, 0.0);
+        for (int64_t i = 0; i < n; ++i)
+            out[i * n + i] = 1.0;
 
-            res[i][j] = sign * det(tmp, rows - 1);
-        }
+        solve(out, size_);
     }
-    return res;
-}
+
+  private:
+    int32_t size_;
+    std::vector<double> factors_;
+    std::vector<int32_t> pivots_;
+    int sign_;
+};
+
 }  // namespace
 
 double S21Matrix::Determinant() const {
+    S21_TRACE_SCOPE("Determinant", rows_, cols_);
     if (this->rows_ != this->cols_)
         throw std::logic_error(
             "The matrix is not square to calculate determinant");
 
-    return det(*this, rows_);
+    return Lu(matrix_, rows_).determinant();
 }
 
 S21Matrix S21Matrix::CalcComplements() const {
+    S21_TRACE_SCOPE("CalcComplements", rows_, cols_);
     if (this->rows_ != this->cols_)
         throw std::logic_error(
             "The matrix is not square to calculate the complements");
-    return adjoint(*this);
+
+    const int32_t n = rows_;
+    S21Matrix res(n, n, uninit);
+    if (n == 1) {
+        res.matrix_[0] = 1;
+        return res;
+    }
+
+    Lu lu(matrix_, n);
+    if (lu.well_conditioned()) {
+        // cof(A) = det(A) * A^-T
+        S21Matrix inverse(n, n, uninit);
+        lu.inverse(inverse.matrix_);
+        const double det = lu.determinant();
+        for (int32_t i = 0; i < n; ++i)
+            for (int32_t j = 0; j < n; ++j)
+                res.matrix_[i * n + j] = det * inverse.matrix_[j * n + i];
+        return res;
+    }
+
+    // Rank-deficient fallback through A = U S V^T:
+    // cof(A) = det(U) det(V) U adj(S) V^T, adj(S)_l being the product of
+    // all singular values but the l-th one.
+    S21Matrix u, sigma, v;
+    Svd(u, sigma, v);
+    const double sign = Lu(u.matrix_, n).determinant() *
+                        Lu(v.matrix_, n).determinant();
+
+    std::vector<double> adj(n, 1.0);
+    for (int32_t l = 1; l < n; ++l)
+        adj[l] = adj[l - 1] * sigma.matrix_[l - 1];
+    double suffix = 1.0;
+    for (int32_t l = n - 1; l >= 0; --l) {
+        adj[l] *= suffix;
+        suffix *= sigma.matrix_[l];
+    }
+
+    for (int32_t i = 0; i < n; ++i)
+        for (int32_t l = 0; l < n; ++l)
+            u.matrix_[i * n + l] *= adj[l];
+    Gemm(sign > 0 ? 1.0 : -1.0, u, false, v, true, 0.0, res);
+
+    return res;
 }
 
 S21Matrix S21Matrix::InverseMatrix() const {
+    S21_TRACE_SCOPE("InverseMatrix", rows_, cols_);
     if (rows_ != cols_)
         throw std::logic_error(
             "The matrix is not square to calculate the inverse");
 
-    double det = Determinant();
-    if (std::fabs(det) < 1e-06)
+    Lu lu(matrix_, rows_);
+    if (std::fabs(lu.determinant()) < 1e-06)
         throw std::logic_error(
             "Determinant can't be zero to calculate inverse");
 
-    S21Matrix adjoint_transposed = CalcComplements().Transpose();
-    S21Matrix res(rows_, cols_);
+    S21Matrix res(rows_, cols_, uninit);
+    lu.inverse(res.matrix_);
 
-    for (int32_t i = 0; i < rows_; ++i)
-        for (int32_t j = 0; j < cols_; ++j)
-            res[i][j] = adjoint_transposed[i][j] / det;
+    return res;
+}
 
+namespace {
+
+S21Matrix identity(int32_t n) {
+    S21Matrix res(n, n);
+    for (int32_t i = 0; i < n; ++i)
+        res[i][i] = 1.0;
     return res;
 }
+
+}  // namespace
+
+S21Matrix S21Matrix::Power(int32_t k) const {
+    S21_TRACE_SCOPE("Power", rows_, cols_);
+    if (rows_ != cols_)
+        throw std::logic_error(
+            "The matrix is not square to calculate the power");
+
+    if (k == 0)
+        return identity(rows_);
+
+    // Binary exponentiation, products go to a spare buffer which is then
+    // swapped in, so nothing is allocated inside the loops.
+    S21Matrix base = k < 0 ? InverseMatrix() : *this;
+    S21Matrix spare(rows_, cols_, uninit);
+    uint32_t e = k < 0 ? 0u - static_cast<uint32_t>(k) : static_cast<uint32_t>(k);
+    for (; (e & 1) == 0; e >>= 1) {
+        Gemm(1.0, base, false, base, false, 0.0, spare);
+        std::swap(base, spare);
+    }
+
+    S21Matrix res = base;
+    for (e >>= 1; e != 0; e >>= 1) {
+        Gemm(1.0, base, false, base, false, 0.0, spare);
+        std::swap(base, spare);
+        if (e & 1) {
+            Gemm(1.0, res, false, base, false, 0.0, spare);
+            std::swap(res, spare);
+        }
+    }
+
+    return res;
+}
+
+namespace {
+
+// out = c0 I + sum of c_i m_i
+void combine(S21Matrix &out, double c0,
+             std::initializer_list<std::pair<double, const S21Matrix *>> terms) {
+    const int32_t n = out.get_rows();
+    for (int32_t i = 0; i < n; ++i) {
+        double *row = out[i];
+        std::fill(row, row + n, 0.0);
+        row[i] = c0;
+        for (const auto &[c, m] : terms) {
+            const double *src = (*m)[i];
+            for (int32_t j = 0; j < n; ++j)
+                row[j] += c * src[j];
+        }
+    }
+}
+
+}  // namespace
+
+// Scaling and squaring with the Pade approximants of Higham, "The scaling
+// and squaring method for the matrix exponential revisited" (2005). The
+// lowest degree whose error bound holds for the 1-norm is used, degree 13
+// after scaling for anything larger.
+S21Matrix S21Matrix::Expm() const {
+    S21_TRACE_SCOPE("Expm", rows_, cols_);
+    if (rows_ != cols_)
+        throw std::logic_error(
+            "The matrix is not square to calculate the exponent");
+
+    const double norm = Norm(NormType::kOne);
+    if (!std::isfinite(norm))
+        throw std::logic_error(
+            "Can't calculate the exponent of a matrix with infinite elements");
+
+    static const double kTheta[] = {1.495585217958292e-2, 2.539398330063230e-1,
+                                    9.504178996162932e-1, 2.097847961257068,
+                                    5.371920351148152};
+    static const double kPade[][14] = {
+        {120, 60, 12, 1},
+        {30240, 15120, 3360, 420, 30, 1},
+        {17297280, 8648640, 1995840, 277200, 25200, 1512, 56, 1},
+        {17643225600, 8821612800, 2075673600, 302702400, 30270240, 2162160,
+         110880, 3960, 90, 1},
+        {64764752532480000, 32382376266240000, 7771770303897600,
+         1187353796428800, 129060195264000, 10559470521600, 670442572800,
+         33522128640, 1323241920, 40840800, 960960, 16380, 182, 1}};
+
+    const int32_t n = rows_;
+    int32_t degree = 0;
+    while (degree < 4 && norm > kTheta[degree])
+        ++degree;
+    int32_t squarings = 0;
+    if (degree == 4 && norm > kTheta[4])
+        squarings = static_cast<int32_t>(std::ceil(std::log2(norm / kTheta[4])));
+
+    S21Matrix a = *this;
+    if (squarings > 0)
+        a.MulNumber(std::ldexp(1.0, -squarings));
+
+    // exp(A) ~ q(A)^-1 p(A), p = v + u and q = v - u where u holds the odd
+    // powers and v the even ones.
+    const double *b = kPade[degree];
+    S21Matrix a2(n, n, uninit), a4(n, n, uninit), a6(n, n, uninit);
+    S21Matrix u(n, n, uninit), v(n, n, uninit), tmp(n, n, uninit);
+    Gemm(1.0, a, false, a, false, 0.0, a2);
+    if (degree >= 1)
+        Gemm(1.0, a2, false, a2, false, 0.0, a4);
+    if (degree >= 2)
+        Gemm(1.0, a4, false, a2, false, 0.0, a6);
+
+    switch (degree) {
+        case 0:
+            combine(tmp, b[1], {{b[3], &a2}});
+            combine(v, b[0], {{b[2], &a2}});
+            break;
+        case 1:
+            combine(tmp, b[1], {{b[3], &a2}, {b[5], &a4}});
+            combine(v, b[0], {{b[2], &a2}, {b[4], &a4}});
+            break;
+        case 2:
+            combine(tmp, b[1], {{b[3], &a2}, {b[5], &a4}, {b[7], &a6}});
+            combine(v, b[0], {{b[2], &a2}, {b[4], &a4}, {b[6], &a6}});
+            break;
+        case 3: {
+            S21Matrix a8(n, n, uninit);
+            Gemm(1.0, a4, false, a4, false, 0.0, a8);
+            combine(tmp, b[1],
+                    {{b[3], &a2}, {b[5], &a4}, {b[7], &a6}, {b[9], &a8}});
+            combine(v, b[0],
+                    {{b[2], &a2}, {b[4], &a4}, {b[6], &a6}, {b[8], &a8}});
+            break;
+        }
+        default:
+            combine(u, 0.0, {{b[13], &a6}, {b[11], &a4}, {b[9], &a2}});
+            combine(tmp, b[1], {{b[7], &a6}, {b[5], &a4}, {b[3], &a2}});
+            Gemm(1.0, a6, false, u, false, 1.0, tmp);
+            combine(u, 0.0, {{b[12], &a6}, {b[10], &a4}, {b[8], &a2}});
+            combine(v, b[0], {{b[6], &a6}, {b[4], &a4}, {b[2], &a2}});
+            Gemm(1.0, a6, false, u, false, 1.0, v);
+    }
+    Gemm(1.0, a, false, tmp, false, 0.0, u);
+
+    // p goes to tmp, q to a2.
+    for (int64_t i = 0, size = static_cast<int64_t>(n) * n; i < size; ++i) {
+        tmp.matrix_[i] = v.matrix_[i] + u.matrix_[i];
+        a2.matrix_[i] = v.matrix_[i] - u.matrix_[i];
+    }
+    Lu(a2.matrix_, n).solve(tmp.matrix_, n);
+
+    // Undo the scaling by squaring, ping-ponging between two buffers.
+    for (int32_t i = 0; i < squarings; ++i) {
+        Gemm(1.0, tmp, false, tmp, false, 0.0, u);
+        std::swap(tmp, u);
+    }
+
+    return tmp;
+}
+
+// The asynchronous variants work on a snapshot of the operands, so the
+// caller is free to modify or destroy them while the future is pending.
+std::future<S21Matrix> S21Matrix::MulAsync(const S21Matrix &other,
+                                           s21::CancelToken token) const {
+    if (cols_ != other.get_rows())
+        throw std::logic_error("Dimensions don't fit for the multiplication");
+
+    return s21::Async([lhs = *this, rhs = other] { return lhs * rhs; }, token);
+}
+
+std::future<S21Matrix> S21Matrix::InverseAsync(s21::CancelToken token) const {
+    return s21::Async([m = *this] { return m.InverseMatrix(); }, token);
+}
+
+std::future<double> S21Matrix::DeterminantAsync(s21::CancelToken token) const {
+    return s21::Async([m = *this] { return m.Determinant(); }, token);
+}
@@ -1,8 +1,18 @@
 #ifndef SRC_S21_MATRIX_H_
 #define SRC_S21_MATRIX_H_
 
-#include <cmath>
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <future>
+#include <stdexcept>
+#include <utility>
+
+#include "s21_executor.hpp"
+
+namespace s21 {
+class Expr;
+}
 
 class S21Matrix {
   private:
@@ -10,8 +20,22 @@ class S21Matrix {
     double *matrix_;
 
   public:
+    enum class Compare { kAbsolute, kRelative, kUlp, kBitwise };
+    enum class NormType { kFrobenius, kOne, kInf, kMax };
+
+    struct DiffResult {
+        double max_error;
+        int32_t row, col;
+    };
+
+    // Tag for a matrix whose contents are about to be fully overwritten,
+    // the elements are left uninitialized.
+    struct Uninit {};
+    static constexpr Uninit uninit{};
+
     S21Matrix();
     S21Matrix(int32_t rows, int32_t cols);
+    S21Matrix(int32_t rows, int32_t cols, Uninit);
     S21Matrix(const S21Matrix &other);
     S21Matrix(S21Matrix &&other) noexcept;
     ~S21Matrix();
@@ -21,15 +45,54 @@ class S21Matrix {
     void set_rows(const int32_t &new_rows);
     void set_cols(const int32_t &new_cols);
 
-    bool EqMatrix(const S21Matrix &other) const;
+    bool EqMatrix(const S21Matrix &other, Compare mode = Compare::kAbsolute,
+                  double tolerance = 1e-07) const;
+    DiffResult Diff(const S21Matrix &other,
+                    Compare mode = Compare::kAbsolute) const;
     void SumMatrix(const S21Matrix &other);
     void SubMatrix(const S21Matrix &other);
     void MulNumber(const double num);
+    void Hadamard(const S21Matrix &other);
+    void BroadcastAdd(const S21Matrix &vector);
+    void BroadcastMul(const S21Matrix &vector);
+    S21Matrix Kronecker(const S21Matrix &other) const;
+
+    // Sums add fixed-size pieces pairwise, so they come out bitwise the same
+    // for any thread count. MinMax and ArgMax skip NaN elements, ArgMax
+    // returns the first maximum in row-major order.
+    double Sum() const;
+    S21Matrix RowSums() const;
+    S21Matrix ColSums() const;
+    double Trace() const;
+    double Norm(NormType type = NormType::kFrobenius) const;
+    std::pair<double, double> MinMax() const;
+    std::pair<int32_t, int32_t> ArgMax() const;
     void MulMatrix(const S21Matrix &other);
+    static void Gemm(double alpha, const S21Matrix &a, bool trans_a,
+                     const S21Matrix &b, bool trans_b, double beta,
+                     S21Matrix &c);
+    static void Gemv(double alpha, const S21Matrix &a, bool trans_a,
+                     const S21Matrix &x, double beta, S21Matrix &y);
+    static void Ger(double alpha, const S21Matrix &x, const S21Matrix &y,
+                    S21Matrix &a);
     S21Matrix Transpose() const;
+    s21::Expr Lazy() const &;
+    s21::Expr Lazy() &&;
     double Determinant() const;
     S21Matrix CalcComplements() const;
     S21Matrix InverseMatrix() const;
+    S21Matrix Power(int32_t k) const;
+    S21Matrix Expm() const;
+
+    std::future<S21Matrix> MulAsync(
+        const S21Matrix &other, s21::CancelToken token = s21::CancelToken()) const;
+    std::future<S21Matrix> InverseAsync(
+        s21::CancelToken token = s21::CancelToken()) const;
+    std::future<double> DeterminantAsync(
+        s21::CancelToken token = s21::CancelToken()) const;
+
+    void SymmetricEigen(S21Matrix &values, S21Matrix &vectors) const;
+    void Svd(S21Matrix &u, S21Matrix &sigma, S21Matrix &v) const;
 
     double *operator[](int32_t row) const;
     double &operator()(int32_t row, int32_t col) const;
@@ -45,12 +108,14 @@ class S21Matrix {
     S21Matrix operator*(const S21Matrix &other) const;
     S21Matrix operator*(const double &value) const;
 
-    bool operator==(const S21Matrix &other) const noexcept;
+    bool operator==(const S21Matrix &other) const;
 
     S21Matrix &operator=(S21Matrix &&other) noexcept;
     S21Matrix &operator=(const S21Matrix &other);
 
     friend S21Matrix operator*(const double &value, const S21Matrix &matrix);
+    friend class S21TriangularMatrix;
+    friend class S21SymmetricMatrix;
 };
 
 #endif  // SRC_S21_MATRIX_H_
@@ -0,0 +1,333 @@
+#include "s21_matrix_structured.hpp"
+
+#include "s21_kernels.hpp"
+#include "s21_trace.hpp"
+
+using s21::kernel::kTriangularBlock;
+
+namespace {
+
+int64_t packed_size(int32_t size) {
+    if (size <= 0)
+        throw std::length_error("Array size can't be zero");
+
+    return static_cast<int64_t>(size) * (size + 1) / 2;
+}
+
+double *row_ptr(double *data, int32_t cols, int32_t row) {
+    return data + static_cast<ptrdiff_t>(row) * cols;
+}
+
+// Blocked triangular kernels on op(T), where the element accessor already
+// applies the transpose and lower tells which triangle op(T) occupies. The
+// off-diagonal panels are packed and handed to gemm, the diagonal blocks
+// are handled row by row.
+template <class Op>
+void trsm(int32_t n, const Op &op, bool lower, double *b, int32_t nrhs) {
+    std::vector<double> panel(static_cast<size_t>(kTriangularBlock) * n);
+
+    auto solve_row = [&](int32_t i, int32_t from, int32_t to) {
+        double *bi = row_ptr(b, nrhs, i);
+        for (int32_t j = from; j < to; ++j)
+            if (j != i)
+                s21::kernel::axpy(nrhs, -op(i, j), row_ptr(b, nrhs, j), bi);
+
+        double diag = op(i, i);
+        if (diag == 0.0)
+            throw std::logic_error("Triangular matrix is singular");
+        for (int32_t k = 0; k < nrhs; ++k)
+            bi[k] /= diag;
+    };
+
+    if (lower) {
+        for (int32_t r0 = 0; r0 < n; r0 += kTriangularBlock) {
+            const int32_t r1 = std::min(n, r0 + kTriangularBlock);
+            if (r0 > 0) {
+                for (int32_t i = r0; i < r1; ++i)
+                    for (int32_t j = 0; j < r0; ++j)
+                        panel[(i - r0) * r0 + j] = op(i, j);
+                s21::kernel::gemm(r1 - r0, nrhs, r0, -1.0,
+                                  {panel.data(), r0, 1}, {b, nrhs, 1}, 1.0,
+                                  row_ptr(b, nrhs, r0), nrhs);
+            }
+            for (int32_t i = r0; i < r1; ++i)
+                solve_row(i, r0, i);
+        }
+    } else {
+        for (int32_t r1 = n; r1 > 0; r1 -= kTriangularBlock) {
+            const int32_t r0 = std::max(0, r1 - kTriangularBlock);
+            const int32_t tail = n - r1;
+            if (tail > 0) {
+                for (int32_t i = r0; i < r1; ++i)
+                    for (int32_t j = 0; j < tail; ++j)
+                        panel[(i - r0) * tail + j] = op(i, r1 + j);
+                s21::kernel::gemm(r1 - r0, nrhs, tail, -1.0,
+                                  {panel.data(), tail, 1},
+                                  {row_ptr(b, nrhs, r1), nrhs, 1}, 1.0,
+                                  row_ptr(b, nrhs, r0), nrhs);
+            }
+            for (int32_t i = r1 - 1; i >= r0; --i)
+                solve_row(i, i + 1, r1);
+        }
+    }
+}
+
+template <class Op>
+void trmm(int32_t n, const Op &op, bool lower, double *b, int32_t nrhs) {
+    std::vector<double> panel(static_cast<size_t>(kTriangularBlock) * n);
+
+    auto mul_row = [&](int32_t i, int32_t from, int32_t to) {
+        double *bi = row_ptr(b, nrhs, i);
+        double diag = op(i, i);
+        for (int32_t k = 0; k < nrhs; ++k)
+            bi[k] *= diag;
+        for (int32_t j = from; j < to; ++j)
+            if (j != i)
+                s21::kernel::axpy(nrhs, op(i, j), row_ptr(b, nrhs, j), bi);
+    };
+
+    // Rows are overwritten in the order that leaves every row still needed
+    // by the remaining products untouched.
+    if (lower) {
+        for (int32_t r1 = n; r1 > 0; r1 -= kTriangularBlock) {
+            const int32_t r0 = std::max(0, r1 - kTriangularBlock);
+            for (int32_t i = r1 - 1; i >= r0; --i)
+                mul_row(i, r0, i);
+            if (r0 > 0) {
+                for (int32_t i = r0; i < r1; ++i)
+                    for (int32_t j = 0; j < r0; ++j)
+                        panel[(i - r0) * r0 + j] = op(i, j);
+                s21::kernel::gemm(r1 - r0, nrhs, r0, 1.0,
+                                  {panel.data(), r0, 1}, {b, nrhs, 1}, 1.0,
+                                  row_ptr(b, nrhs, r0), nrhs);
+            }
+        }
+    } else {
+        for (int32_t r0 = 0; r0 < n; r0 += kTriangularBlock) {
+            const int32_t r1 = std::min(n, r0 + kTriangularBlock);
+            const int32_t tail = n - r1;
+            for (int32_t i = r0; i < r1; ++i)
+                mul_row(i, i + 1, r1);
+            if (tail > 0) {
+                for (int32_t i = r0; i < r1; ++i)
+                    for (int32_t j = 0; j < tail; ++j)
+                        panel[(i - r0) * tail + j] = op(i, r1 + j);
+                s21::kernel::gemm(r1 - r0, nrhs, tail, 1.0,
+                                  {panel.data(), tail, 1},
+                                  {row_ptr(b, nrhs, r1), nrhs, 1}, 1.0,
+                                  row_ptr(b, nrhs, r0), nrhs);
+            }
+        }
+    }
+}
+
+}  // namespace
+
+S21TriangularMatrix::S21TriangularMatrix(int32_t size, Uplo uplo)
+    : size_(size), uplo_(uplo), packed_(packed_size(size)) {
+}
+
+S21TriangularMatrix::S21TriangularMatrix(const S21Matrix &dense, Uplo uplo)
+    : S21TriangularMatrix(dense.rows_, uplo) {
+    if (dense.rows_ != dense.cols_)
+        throw std::logic_error("Triangular matrix has to be square");
+
+    for (int32_t i = 0; i < size_; ++i)
+        for (int32_t j = 0; j < size_; ++j)
+            if (stored(i, j))
+                packed_[index(i, j)] = dense.matrix_[i * size_ + j];
+}
+
+int64_t S21TriangularMatrix::index(int32_t row, int32_t col) const noexcept {
+    if (uplo_ == Uplo::kLower)
+        return static_cast<int64_t>(row) * (row + 1) / 2 + col;
+
+    return static_cast<int64_t>(row) * size_ -
+           static_cast<int64_t>(row) * (row - 1) / 2 + (col - row);
+}
+
+bool S21TriangularMatrix::stored(int32_t row, int32_t col) const noexcept {
+    return uplo_ == Uplo::kLower ? col <= row : col >= row;
+}
+
+int32_t S21TriangularMatrix::get_size() const noexcept {
+    return size_;
+}
+
+S21TriangularMatrix::Uplo S21TriangularMatrix::get_uplo() const noexcept {
+    return uplo_;
+}
+
+double &S21TriangularMatrix::operator()(int32_t row, int32_t col) {
+    if (row >= size_ || col >= size_ || row < 0 || col < 0)
+        throw std::out_of_range("Incorrect input, index is out of range");
+    if (!stored(row, col))
+        throw std::out_of_range("The element is outside of the triangle");
+
+    return packed_[index(row, col)];
+}
+
+double S21TriangularMatrix::operator()(int32_t row, int32_t col) const {
+    if (row >= size_ || col >= size_ || row < 0 || col < 0)
+        throw std::out_of_range("Incorrect input, index is out of range");
+
+    return stored(row, col) ? packed_[index(row, col)] : 0.0;
+}
+
+S21Matrix S21TriangularMatrix::ToDense() const {
+    S21Matrix res(size_, size_);
+    for (int32_t i = 0; i < size_; ++i)
+        for (int32_t j = 0; j < size_; ++j)
+            if (stored(i, j))
+                res.matrix_[i * size_ + j] = packed_[index(i, j)];
+
+    return res;
+}
+
+S21Matrix S21TriangularMatrix::Solve(const S21Matrix &b, bool trans) const {
+    S21_TRACE_SCOPE("S21TriangularMatrix::Solve", b.get_rows(), b.get_cols());
+    if (b.rows_ != size_)
+        throw std::logic_error("Dimensions don't fit for the triangular solve");
+
+    S21Matrix x{b};
+    const bool lower = (uplo_ == Uplo::kLower) != trans;
+    if (trans)
+        trsm(size_, [this](int32_t i, int32_t j) { return packed_[index(j, i)]; },
+             lower, x.matrix_, x.cols_);
+    else
+        trsm(size_, [this](int32_t i, int32_t j) { return packed_[index(i, j)]; },
+             lower, x.matrix_, x.cols_);
+
+    return x;
+}
+
+S21Matrix S21TriangularMatrix::Multiply(const S21Matrix &b, bool trans) const {
+    S21_TRACE_SCOPE("S21TriangularMatrix::Multiply", b.get_rows(), b.get_cols());
+    if (b.rows_ != size_)
+        throw std::logic_error("Dimensions don't fit for the multiplication");
+
+    S21Matrix res{b};
+    const bool lower = (uplo_ == Uplo::kLower) != trans;
+    if (trans)
+        trmm(size_, [this](int32_t i, int32_t j) { return packed_[index(j, i)]; },
+             lower, res.matrix_, res.cols_);
+    else
+        trmm(size_, [this](int32_t i, int32_t j) { return packed_[index(i, j)]; },
+             lower, res.matrix_, res.cols_);
+
+    return res;
+}
+
+S21Matrix S21TriangularMatrix::operator*(const S21Matrix &b) const {
+    return Multiply(b);
+}
+
+S21SymmetricMatrix::S21SymmetricMatrix(int32_t size)
+    : size_(size), packed_(packed_size(size)) {
+}
+
+S21SymmetricMatrix::S21SymmetricMatrix(const S21Matrix &dense)
+    : S21SymmetricMatrix(dense.rows_) {
+    if (dense.rows_ != dense.cols_)
+        throw std::logic_error("Symmetric matrix has to be square");
+
+    // Same relative tolerance as S21Matrix::SymmetricEigen.
+    const double tolerance =
+        1e-07 * std::max(1.0, dense.Norm(S21Matrix::NormType::kMax));
+    for (int32_t i = 0; i < size_; ++i) {
+        for (int32_t j = 0; j <= i; ++j) {
+            double lower = dense.matrix_[i * size_ + j];
+            if (std::fabs(lower - dense.matrix_[j * size_ + i]) > tolerance)
+                throw std::logic_error("The matrix is not symmetric");
+            packed_[index(i, j)] = lower;
+        }
+    }
+}
+
+int64_t S21SymmetricMatrix::index(int32_t row, int32_t col) const noexcept {
+    if (col > row)
+        std::swap(row, col);
+
+    return static_cast<int64_t>(row) * (row + 1) / 2 + col;
+}
+
+int32_t S21SymmetricMatrix::get_size() const noexcept {
+    return size_;
+}
+
+double &S21SymmetricMatrix::operator()(int32_t row, int32_t col) {
+    if (row >= size_ || col >= size_ || row < 0 || col < 0)
+        throw std::out_of_range("Incorrect input, index is out of range");
+
+    return packed_[index(row, col)];
+}
+
+double S21SymmetricMatrix::operator()(int32_t row, int32_t col) const {
+    if (row >= size_ || col >= size_ || row < 0 || col < 0)
+        throw std::out_of_range("Incorrect input, index is out of range");
+
+    return packed_[index(row, col)];
+}
+
+S21Matrix S21SymmetricMatrix::ToDense() const {
+    S21Matrix res(size_, size_);
+    for (int32_t i = 0; i < size_; ++i)
+        for (int32_t j = 0; j <= i; ++j)
+            res.matrix_[i * size_ + j] = res.matrix_[j * size_ + i] =
+                packed_[index(i, j)];
+
+    return res;
+}
+
+void S21SymmetricMatrix::Syrk(double alpha, const S21Matrix &a, bool trans,
+                              double beta) {
+    S21_TRACE_SCOPE("S21SymmetricMatrix::Syrk", size_, size_);
+    const int32_t n = trans ? a.cols_ : a.rows_;
+    const int32_t k = trans ? a.rows_ : a.cols_;
+    if (n != size_)
+        throw std::logic_error("Dimensions don't fit for the rank-k update");
+
+    // Only the block rows up to the diagonal are computed, which is half of
+    // the equivalent dense product.
+    std::vector<double> tmp(static_cast<size_t>(kTriangularBlock) * n);
+    for (int32_t r0 = 0; r0 < n; r0 += kTriangularBlock) {
+        const int32_t r1 = std::min(n, r0 + kTriangularBlock);
+        s21::kernel::View rows =
+            trans ? s21::kernel::View{a.matrix_ + r0, 1, n}
+                  : s21::kernel::View{a.matrix_ + static_cast<ptrdiff_t>(r0) * k,
+                                      k, 1};
+        s21::kernel::View cols = trans ? s21::kernel::View{a.matrix_, n, 1}
+                                       : s21::kernel::View{a.matrix_, 1, k};
+        s21::kernel::gemm(r1 - r0, r1, k, alpha, rows, cols, 0.0, tmp.data(),
+                          r1);
+
+        for (int32_t i = r0; i < r1; ++i) {
+            double *dst = packed_.data() + index(i, 0);
+            const double *src = tmp.data() + static_cast<ptrdiff_t>(i - r0) * r1;
+            for (int32_t j = 0; j <= i; ++j)
+                dst[j] = (beta == 0.0 ? 0.0 : beta * dst[j]) + src[j];
+        }
+    }
+}
+
+S21Matrix S21SymmetricMatrix::operator*(const S21Matrix &b) const {
+    if (b.rows_ != size_)
+        throw std::logic_error("Dimensions don't fit for the multiplication");
+
+    // Each block row is unfolded from the packed triangle into a dense
+    // panel and multiplied on the gemm core.
+    S21Matrix res(size_, b.cols_, S21Matrix::uninit);
+    std::vector<double> panel(static_cast<size_t>(kTriangularBlock) * size_);
+    for (int32_t r0 = 0; r0 < size_; r0 += kTriangularBlock) {
+        const int32_t r1 = std::min(size_, r0 + kTriangularBlock);
+        for (int32_t i = r0; i < r1; ++i)
+            for (int32_t j = 0; j < size_; ++j)
+                panel[(i - r0) * size_ + j] = packed_[index(i, j)];
+
+        s21::kernel::gemm(r1 - r0, b.cols_, size_, 1.0,
+                          {panel.data(), size_, 1}, {b.matrix_, b.cols_, 1}, 0.0,
+                          row_ptr(res.matrix_, res.cols_, r0), res.cols_);
+    }
+
+    return res;
+}
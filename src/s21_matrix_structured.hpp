@@ -0,0 +1,63 @@
+#ifndef SRC_S21_MATRIX_STRUCTURED_H_
+#define SRC_S21_MATRIX_STRUCTURED_H_
+
+#include <vector>
+
+#include "s21_matrix_oop.hpp"
+
+// Square triangular matrix in packed row-major storage: only the n(n+1)/2
+// elements of the stored triangle are kept.
+class S21TriangularMatrix {
+  public:
+    enum class Uplo { kLower, kUpper };
+
+  private:
+    int32_t size_;
+    Uplo uplo_;
+    std::vector<double> packed_;
+
+    int64_t index(int32_t row, int32_t col) const noexcept;
+    bool stored(int32_t row, int32_t col) const noexcept;
+
+  public:
+    explicit S21TriangularMatrix(int32_t size, Uplo uplo = Uplo::kLower);
+    explicit S21TriangularMatrix(const S21Matrix &dense,
+                                 Uplo uplo = Uplo::kLower);
+
+    int32_t get_size() const noexcept;
+    Uplo get_uplo() const noexcept;
+
+    double &operator()(int32_t row, int32_t col);
+    double operator()(int32_t row, int32_t col) const;
+
+    S21Matrix ToDense() const;
+    S21Matrix Solve(const S21Matrix &b, bool trans = false) const;
+    S21Matrix Multiply(const S21Matrix &b, bool trans = false) const;
+
+    S21Matrix operator*(const S21Matrix &b) const;
+};
+
+// Symmetric matrix, only the lower triangle is stored (packed row-major).
+class S21SymmetricMatrix {
+  private:
+    int32_t size_;
+    std::vector<double> packed_;
+
+    int64_t index(int32_t row, int32_t col) const noexcept;
+
+  public:
+    explicit S21SymmetricMatrix(int32_t size);
+    explicit S21SymmetricMatrix(const S21Matrix &dense);
+
+    int32_t get_size() const noexcept;
+
+    double &operator()(int32_t row, int32_t col);
+    double operator()(int32_t row, int32_t col) const;
+
+    S21Matrix ToDense() const;
+    void Syrk(double alpha, const S21Matrix &a, bool trans, double beta);
+
+    S21Matrix operator*(const S21Matrix &b) const;
+};
+
+#endif  // SRC_S21_MATRIX_STRUCTURED_H_
@@ -0,0 +1,167 @@
+#include "s21_numa.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace s21 {
+
+namespace {
+
+// Parses sysfs lists such as "0-3,8,10-11".
+std::vector<int32_t> read_list(const std::string &path) {
+    std::vector<int32_t> ids;
+    std::ifstream file(path);
+    std::string token;
+    while (std::getline(file, token, ',')) {
+        std::istringstream range(token);
+        int32_t first = 0, last = 0;
+        char dash = 0;
+        if (!(range >> first))
+            continue;
+        last = (range >> dash >> last) ? last : first;
+        for (int32_t id = first; id <= last; ++id)
+            ids.push_back(id);
+    }
+    return ids;
+}
+
+const std::vector<int32_t> &online_nodes() {
+    static const std::vector<int32_t> nodes = [] {
+        std::vector<int32_t> found =
+            read_list("/sys/devices/system/node/online");
+        return found.empty() ? std::vector<int32_t>{0} : found;
+    }();
+    return nodes;
+}
+
+std::atomic<NumaPolicy> &policy() {
+    static std::atomic<NumaPolicy> current{numa_node_count() > 1
+                                               ? NumaPolicy::kInterleave
+                                               : NumaPolicy::kFirstTouch};
+    return current;
+}
+
+#ifdef __linux__
+constexpr int kMpolInterleave = 3;
+
+void interleave(void *data, size_t bytes) {
+    const std::vector<int32_t> &nodes = online_nodes();
+    const int32_t max_node = nodes.back() + 1;
+    std::vector<unsigned long> mask(max_node / (8 * sizeof(unsigned long)) + 1);
+    for (int32_t node : nodes)
+        mask[node / (8 * sizeof(unsigned long))] |=
+            1UL << (node % (8 * sizeof(unsigned long)));
+
+    // Kernels without NUMA support reject the call, the mapping then
+    // simply falls back to first touch.
+    syscall(SYS_mbind, data, bytes, kMpolInterleave, mask.data(),
+            mask.size() * 8 * sizeof(unsigned long), 0);
+}
+
+// CPUs this process may run on, ordered node by node.
+std::vector<int32_t> cpus_by_node() {
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+        return {};
+
+    std::vector<int32_t> cpus;
+    for (int32_t node : online_nodes())
+        for (int32_t cpu : read_list("/sys/devices/system/node/node" +
+                                     std::to_string(node) + "/cpulist"))
+            if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed) &&
+                std::find(cpus.begin(), cpus.end(), cpu) == cpus.end())
+                cpus.push_back(cpu);
+
+    if (cpus.empty())
+        for (int32_t cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+            if (CPU_ISSET(cpu, &allowed))
+                cpus.push_back(cpu);
+    return cpus;
+}
+
+bool pinning_enabled() {
+    const char *env = std::getenv("S21_PIN_THREADS");
+    if (env != nullptr)
+        return std::string(env) != "0";
+    return numa_node_count() > 1;
+}
+#endif
+
+}  // namespace
+
+int32_t numa_node_count() {
+    return static_cast<int32_t>(online_nodes().size());
+}
+
+NumaPolicy get_numa_policy() {
+    return policy().load();
+}
+
+void set_numa_policy(NumaPolicy value) {
+    policy().store(value);
+}
+
+double *allocate(int64_t size, bool zero) {
+#ifdef __linux__
+    if (size >= kLargeAllocation) {
+        const size_t bytes = size * sizeof(double);
+        void *data = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (data == MAP_FAILED)
+            throw std::bad_alloc();
+        if (get_numa_policy() == NumaPolicy::kInterleave)
+            interleave(data, bytes);
+        return static_cast<double *>(data);
+    }
+#endif
+    return zero ? new double[size]() : new double[size];
+}
+
+void deallocate(double *data, int64_t size) noexcept {
+    if (data == nullptr)
+        return;
+#ifdef __linux__
+    if (size >= kLargeAllocation) {
+        munmap(data, size * sizeof(double));
+        return;
+    }
+#endif
+    delete[] data;
+}
+
+int32_t pin_worker(int32_t worker) {
+#ifdef __linux__
+    static const bool enabled = pinning_enabled();
+    if (!enabled)
+        return -1;
+
+    static const std::vector<int32_t> cpus = cpus_by_node();
+    if (cpus.empty())
+        return -1;
+
+    const int32_t cpu = cpus[worker % cpus.size()];
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0 ? cpu : -1;
+#else
+    static_cast<void>(worker);
+    return -1;
+#endif
+}
+
+}  // namespace s21
@@ -0,0 +1,39 @@
+#ifndef SRC_S21_NUMA_H_
+#define SRC_S21_NUMA_H_
+
+#include <cstdint>
+
+namespace s21 {
+
+// Where the pages of large matrix buffers end up. kInterleave spreads them
+// round-robin over the memory nodes, kFirstTouch leaves them to the node of
+// the thread that writes them first. Buffers are mapped lazily in both
+// cases. Under kFirstTouch on a multi-node machine matrices zero and copy
+// their large buffers through parallel_for row ranges, so each range lands
+// on the node of the worker that row-wise operations later give it to.
+enum class NumaPolicy { kFirstTouch, kInterleave };
+
+// Buffers of at least this many elements get their own mapping.
+constexpr int64_t kLargeAllocation = 1 << 18;
+
+int32_t numa_node_count();
+
+NumaPolicy get_numa_policy();
+void set_numa_policy(NumaPolicy policy);
+
+// Buffer released with deallocate() and the same size. Large buffers are
+// always zeroed since fresh mappings come zeroed for free.
+double *allocate(int64_t size, bool zero = true);
+void deallocate(double *data, int64_t size) noexcept;
+
+// Pins the calling executor worker to a CPU, workers are spread over the
+// nodes in order. parallel_for gives part p to worker (p % threads) - 1 (the
+// caller takes the parts with p % threads == 0), so the same range of the
+// same loop shape runs on the same node every time unless its worker is
+// busy. Enabled by default on multi-node machines, S21_PIN_THREADS=0/1
+// overrides it. Returns the CPU or -1 when the thread was left alone.
+int32_t pin_worker(int32_t worker);
+
+}  // namespace s21
+
+#endif  // SRC_S21_NUMA_H_
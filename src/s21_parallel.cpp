@@ -0,0 +1,130 @@
+#include "s21_parallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include "s21_executor.hpp"
+#include "s21_tuning.hpp"
+
+namespace s21 {
+
+int64_t parallel_cutoff() {
+    return tuning().parallel_cutoff;
+}
+
+int32_t concurrency() {
+    static const int32_t threads =
+        std::max(1u, std::thread::hardware_concurrency());
+    return threads;
+}
+
+namespace {
+
+std::atomic<int32_t> thread_limit{0};
+std::atomic<bool> reproducible{false};
+
+}  // namespace
+
+void set_max_threads(int32_t threads) {
+    if (threads < 0)
+        throw std::logic_error("Thread count can't be negative");
+    thread_limit = threads;
+}
+
+int32_t max_threads() {
+    const int32_t limit = thread_limit;
+    return limit > 0 ? limit : concurrency();
+}
+
+void set_reproducible(bool enabled) {
+    reproducible = enabled;
+}
+
+bool is_reproducible() {
+    return reproducible;
+}
+
+namespace {
+
+// Part p belongs to slot p % threads: slot 0 is the caller, slot s is
+// executor worker s - 1. The same n, grain and thread count therefore give
+// every range to the same worker, so pages a pinned worker first touched
+// are the ones it computes on later. A part is taken at most once, whoever
+// owns it takes it first, and the caller finishes with any part its owner
+// hasn't started. The caller never waits for a range nobody has picked up,
+// so a busy pool only costs parallelism and locality, not progress.
+struct ParallelRun {
+    std::unique_ptr<std::atomic<bool>[]> taken;
+    int64_t finished = 0;
+    std::exception_ptr error;
+    std::mutex mutex;
+    std::condition_variable all_done;
+};
+
+void run_part(const std::shared_ptr<ParallelRun> &run, int64_t n,
+              int64_t parts, int64_t part,
+              const std::function<void(int64_t, int64_t)> &body) {
+    if (run->taken[part].exchange(true))
+        return;
+
+    std::exception_ptr error;
+    try {
+        body(n * part / parts, n * (part + 1) / parts);
+    } catch (...) {
+        error = std::current_exception();
+    }
+
+    std::lock_guard<std::mutex> lock(run->mutex);
+    if (error && !run->error)
+        run->error = error;
+    if (++run->finished == parts)
+        run->all_done.notify_all();
+}
+
+void run_slot(const std::shared_ptr<ParallelRun> &run, int64_t n,
+              int64_t parts, int64_t slot, int64_t slots,
+              const std::function<void(int64_t, int64_t)> &body) {
+    for (int64_t part = slot; part < parts; part += slots)
+        run_part(run, n, parts, part, body);
+}
+
+}  // namespace
+
+void parallel_for(int64_t n, int64_t grain,
+                  const std::function<void(int64_t, int64_t)> &body) {
+    const int64_t pieces =
+        std::max<int64_t>(1, n / std::max<int64_t>(grain, 1));
+    const int64_t threads = std::min<int64_t>(max_threads(), pieces);
+    const int64_t parts = is_reproducible() ? pieces : threads;
+    if (threads <= 1) {
+        for (int64_t part = 0; part < parts; ++part)
+            body(n * part / parts, n * (part + 1) / parts);
+        return;
+    }
+
+    auto run = std::make_shared<ParallelRun>();
+    run->taken.reset(new std::atomic<bool>[parts]());
+    const auto *shared_body = &body;
+    for (int64_t slot = 1; slot < threads; ++slot)
+        Executor::Instance().SubmitTo(
+            static_cast<int32_t>(slot - 1),
+            [run, n, parts, slot, threads, shared_body] {
+                run_slot(run, n, parts, slot, threads, *shared_body);
+            });
+    run_slot(run, n, parts, 0, threads, body);
+    for (int64_t part = 0; part < parts; ++part)
+        run_part(run, n, parts, part, body);
+
+    std::unique_lock<std::mutex> lock(run->mutex);
+    run->all_done.wait(lock, [&] { return run->finished == parts; });
+    if (run->error)
+        std::rethrow_exception(run->error);
+}
+
+}  // namespace s21
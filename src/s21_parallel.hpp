@@ -0,0 +1,34 @@
+#ifndef SRC_S21_PARALLEL_H_
+#define SRC_S21_PARALLEL_H_
+
+#include <cstdint>
+#include <functional>
+
+namespace s21 {
+
+// Problems smaller than this many elements are not worth a thread, see
+// TuningParams.
+int64_t parallel_cutoff();
+
+int32_t concurrency();
+
+// Caps the threads parallel_for uses, 0 restores the hardware concurrency.
+void set_max_threads(int32_t threads);
+int32_t max_threads();
+
+// In the reproducible mode parallel_for ranges depend only on n and grain,
+// never on the number of threads, so any per-range accumulation comes out
+// bitwise the same on every machine. Off by default, the fast mode gives
+// each thread one range.
+void set_reproducible(bool enabled);
+bool is_reproducible();
+
+// Splits [0, n) into contiguous ranges of at least grain elements and runs
+// body(begin, end) on each of them, the calling thread takes part. Ranges
+// go to threads by a fixed mapping, see pin_worker.
+void parallel_for(int64_t n, int64_t grain,
+                  const std::function<void(int64_t, int64_t)> &body);
+
+}  // namespace s21
+
+#endif  // SRC_S21_PARALLEL_H_
@@ -0,0 +1,133 @@
+#include "s21_trace.hpp"
+
+#include <algorithm>
+#include <fstream>
+
+#ifdef S21_TRACING
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+#endif
+
+namespace s21 {
+namespace trace {
+
+#ifdef S21_TRACING
+
+namespace {
+
+struct Event {
+    const char *name;
+    int64_t rows, cols;
+    int64_t start, duration;
+};
+
+constexpr int64_t kRingSize = 1 << 14;
+
+// Only the owning thread writes, the head is published with release so a
+// reader sees complete events. Once full the oldest events are overwritten.
+struct Ring {
+    int32_t thread;
+    std::atomic<int64_t> head{0};
+    std::vector<Event> events = std::vector<Event>(kRingSize);
+};
+
+// Rings outlive their threads so spans of finished workers still show up.
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<Ring>> rings;
+};
+
+Registry &registry() {
+    static Registry instance;
+    return instance;
+}
+
+Ring &local_ring() {
+    thread_local std::shared_ptr<Ring> ring = [] {
+        auto created = std::make_shared<Ring>();
+        Registry &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        created->thread = static_cast<int32_t>(reg.rings.size()) + 1;
+        reg.rings.push_back(created);
+        return created;
+    }();
+    return *ring;
+}
+
+int64_t now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+// The format wants microseconds, nanoseconds go after the point.
+void write_micros(std::ostream &out, int64_t ns) {
+    out << ns / 1000 << '.' << ns % 1000 / 100 << ns % 100 / 10 << ns % 10;
+}
+
+}  // namespace
+
+Scope::Scope(const char *name, int64_t rows, int64_t cols) noexcept
+    : name_(name), rows_(rows), cols_(cols), start_(now()) {
+}
+
+Scope::~Scope() {
+    const int64_t end = now();
+    Ring &ring = local_ring();
+    const int64_t head = ring.head.load(std::memory_order_relaxed);
+    ring.events[head % kRingSize] = {name_, rows_, cols_, start_, end - start_};
+    ring.head.store(head + 1, std::memory_order_release);
+}
+
+void write_json(std::ostream &out) {
+    Registry &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    out << "{\"traceEvents\":[";
+    bool first = true;
+    for (const auto &ring : reg.rings) {
+        const int64_t head = ring->head.load(std::memory_order_acquire);
+        for (int64_t i = std::max<int64_t>(0, head - kRingSize); i < head; ++i) {
+            const Event &e = ring->events[i % kRingSize];
+            out << (first ? "" : ",") << "\n{\"name\":\"" << e.name
+                << "\",\"cat\":\"s21\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+                << ring->thread << ",\"ts\":";
+            write_micros(out, e.start);
+            out << ",\"dur\":";
+            write_micros(out, e.duration);
+            out << ",\"args\":{\"rows\":" << e.rows << ",\"cols\":" << e.cols
+                << "}}";
+            first = false;
+        }
+    }
+    out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+}
+
+void clear() {
+    Registry &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (const auto &ring : reg.rings)
+        ring->head.store(0, std::memory_order_release);
+}
+
+#else
+
+void write_json(std::ostream &out) {
+    out << "{\"traceEvents\":[],\"displayTimeUnit\":\"ns\"}\n";
+}
+
+void clear() {
+}
+
+#endif
+
+bool write_json(const std::string &path) {
+    std::ofstream file(path, std::ios::trunc);
+    write_json(file);
+    return static_cast<bool>(file);
+}
+
+}  // namespace trace
+}  // namespace s21
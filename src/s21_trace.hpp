@@ -0,0 +1,50 @@
+#ifndef SRC_S21_TRACE_H_
+#define SRC_S21_TRACE_H_
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace s21 {
+namespace trace {
+
+// Writes the spans recorded so far as Chrome trace-event JSON, loadable in
+// chrome://tracing and Perfetto. Spans still being written by other threads
+// may be torn, flush when no operation is running. Without S21_TRACING the
+// trace is empty.
+void write_json(std::ostream &out);
+bool write_json(const std::string &path);
+void clear();
+
+#ifdef S21_TRACING
+// Records name, size, thread and duration of its lifetime into the ring
+// buffer of the calling thread. name has to be a string literal.
+class Scope {
+  private:
+    const char *name_;
+    int64_t rows_, cols_;
+    int64_t start_;
+
+  public:
+    Scope(const char *name, int64_t rows, int64_t cols) noexcept;
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+    ~Scope();
+};
+#endif
+
+}  // namespace trace
+}  // namespace s21
+
+// Compiles to nothing, arguments included, unless the library is built
+// with the S21_TRACING CMake option.
+#ifdef S21_TRACING
+#define S21_TRACE_CONCAT_(a, b) a##b
+#define S21_TRACE_CONCAT(a, b) S21_TRACE_CONCAT_(a, b)
+#define S21_TRACE_SCOPE(name, rows, cols) \
+    s21::trace::Scope S21_TRACE_CONCAT(s21_trace_, __LINE__)(name, rows, cols)
+#else
+#define S21_TRACE_SCOPE(name, rows, cols) static_cast<void>(0)
+#endif
+
+#endif  // SRC_S21_TRACE_H_
@@ -0,0 +1,213 @@
+#include "s21_tuning.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "s21_kernels.hpp"
+#include "s21_parallel.hpp"
+
+namespace s21 {
+
+namespace {
+
+bool valid(const TuningParams &params) {
+    return params.gemm_block_m > 0 && params.gemm_block_k > 0 &&
+           params.gemm_block_n > 0 && params.transpose_block > 0 &&
+           params.parallel_cutoff > 0;
+}
+
+TuningParams &active() {
+    static TuningParams params = [] {
+        TuningParams cached;
+        return load_tuning(tuning_cache_path(), cpu_model(), cached)
+                   ? cached
+                   : TuningParams();
+    }();
+    return params;
+}
+
+const TuningParams kDefaults;
+
+// Best of a few runs, in seconds.
+double measure(const std::function<void()> &work) {
+    double best = 1e300;
+    for (int32_t run = 0; run < 3; ++run) {
+        auto start = std::chrono::steady_clock::now();
+        work();
+        std::chrono::duration<double> spent =
+            std::chrono::steady_clock::now() - start;
+        best = std::min(best, spent.count());
+    }
+    return best;
+}
+
+}  // namespace
+
+const TuningParams &tuning() {
+    return is_reproducible() ? kDefaults : active();
+}
+
+void set_tuning(const TuningParams &params) {
+    if (!valid(params))
+        throw std::logic_error("Tuning parameters must be positive");
+    active() = params;
+}
+
+std::string cpu_model() {
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    for (std::string line; std::getline(cpuinfo, line);) {
+        if (line.rfind("model name", 0) != 0)
+            continue;
+        const size_t colon = line.find(':');
+        if (colon != std::string::npos && colon + 2 <= line.size())
+            return line.substr(colon + 2);
+    }
+    return "unknown";
+}
+
+std::string tuning_cache_path() {
+    if (const char *path = std::getenv("S21_TUNING_CACHE"))
+        return path;
+    if (const char *cache = std::getenv("XDG_CACHE_HOME"))
+        return std::string(cache) + "/s21_matrix/tuning";
+    if (const char *home = std::getenv("HOME"))
+        return std::string(home) + "/.cache/s21_matrix/tuning";
+    return "s21_matrix_tuning";
+}
+
+bool load_tuning(const std::string &path, const std::string &model,
+                 TuningParams &params) {
+    std::ifstream file(path);
+    for (std::string line; std::getline(file, line);) {
+        const size_t tab = line.find('\t');
+        if (tab == std::string::npos || line.compare(0, tab, model) != 0 ||
+            tab != model.size())
+            continue;
+
+        TuningParams parsed;
+        std::istringstream values(line.substr(tab + 1));
+        if (values >> parsed.gemm_block_m >> parsed.gemm_block_k >>
+                parsed.gemm_block_n >> parsed.transpose_block >>
+                parsed.parallel_cutoff &&
+            valid(parsed)) {
+            params = parsed;
+            return true;
+        }
+    }
+    return false;
+}
+
+void save_tuning(const std::string &path, const std::string &model,
+                 const TuningParams &params) {
+    std::vector<std::string> lines;
+    {
+        std::ifstream file(path);
+        for (std::string line; std::getline(file, line);)
+            if (line.compare(0, model.size() + 1, model + '\t') != 0)
+                lines.push_back(line);
+    }
+
+    std::ostringstream entry;
+    entry << model << '\t' << params.gemm_block_m << ' ' << params.gemm_block_k
+          << ' ' << params.gemm_block_n << ' ' << params.transpose_block << ' '
+          << params.parallel_cutoff;
+    lines.push_back(entry.str());
+
+    const std::filesystem::path target(path);
+    if (target.has_parent_path())
+        std::filesystem::create_directories(target.parent_path());
+    std::ofstream file(path, std::ios::trunc);
+    for (const std::string &line : lines)
+        file << line << '\n';
+    if (!file)
+        throw std::runtime_error("Can't write the tuning cache " + path);
+}
+
+TuningParams autotune(const std::function<void(const std::string &)> &log) {
+    auto report = [&](const std::string &message) {
+        if (log)
+            log(message);
+    };
+    const TuningParams saved = active();
+    TuningParams best = saved;
+
+    // GEMM blocks on a product large enough to leave the caches.
+    const int32_t size = 384;
+    std::vector<double> a(size * size, 1.0), b(size * size, 0.5),
+        c(size * size);
+    double best_time = 1e300;
+    for (int32_t m : {32, 64, 128})
+        for (int32_t k : {64, 128, 256})
+            for (int32_t n : {128, 256, 512}) {
+                TuningParams candidate = best;
+                candidate.gemm_block_m = m;
+                candidate.gemm_block_k = k;
+                candidate.gemm_block_n = n;
+                active() = candidate;
+                const double time = measure([&] {
+                    kernel::gemm(size, size, size, 1.0,
+                                 kernel::view(a.data(), size, false),
+                                 kernel::view(b.data(), size, false), 0.0,
+                                 c.data(), size);
+                });
+                if (time < best_time) {
+                    best_time = time;
+                    best = candidate;
+                }
+            }
+    report("gemm blocks " + std::to_string(best.gemm_block_m) + " x " +
+           std::to_string(best.gemm_block_k) + " x " +
+           std::to_string(best.gemm_block_n));
+
+    const int32_t side = 2048;
+    std::vector<double> src(static_cast<size_t>(side) * side, 1.0),
+        dst(src.size());
+    best_time = 1e300;
+    for (int32_t block : {8, 16, 32, 64, 128}) {
+        TuningParams candidate = best;
+        candidate.transpose_block = block;
+        active() = candidate;
+        const double time = measure(
+            [&] { kernel::transpose(side, side, src.data(), dst.data()); });
+        if (time < best_time) {
+            best_time = time;
+            best = candidate;
+        }
+    }
+    report("transpose block " + std::to_string(best.transpose_block));
+
+    // The smallest elementwise sweep that already gains from threads.
+    if (max_threads() > 1) {
+        std::vector<double> data(1 << 22, 1.0);
+        const int32_t threads = max_threads();
+        // One range per thread in either mode, reproducible mode would
+        // otherwise time one call per element.
+        auto sweep = [&](int64_t n) {
+            parallel_for(n, n / threads, [&](int64_t first, int64_t last) {
+                for (int64_t i = first; i < last; ++i)
+                    data[i] = data[i] * 0.5 + 1.0;
+            });
+        };
+        for (int64_t n = 1 << 12; n <= (1 << 22); n *= 2) {
+            const double parallel = measure([&] { sweep(n); });
+            set_max_threads(1);
+            const double serial = measure([&] { sweep(n); });
+            set_max_threads(threads);
+            if (parallel < serial) {
+                best.parallel_cutoff = n;
+                break;
+            }
+        }
+    }
+    report("parallel cutoff " + std::to_string(best.parallel_cutoff));
+
+    active() = saved;
+    return best;
+}
+
+}  // namespace s21
@@ -0,0 +1,50 @@
+#ifndef SRC_S21_TUNING_H_
+#define SRC_S21_TUNING_H_
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace s21 {
+
+// Machine dependent kernel parameters.
+struct TuningParams {
+    int32_t gemm_block_m = 64;
+    int32_t gemm_block_k = 128;
+    int32_t gemm_block_n = 256;
+    int32_t transpose_block = 32;
+    // Problems smaller than this many elements are not worth a thread.
+    int64_t parallel_cutoff = 1 << 18;
+};
+
+// The parameters in effect. The first call loads the entry for this CPU
+// model from the tuning cache and keeps the defaults if there is none. The
+// reproducible mode always runs with the defaults.
+const TuningParams &tuning();
+
+// Kernels read the parameters without locking, set them before starting
+// any work.
+void set_tuning(const TuningParams &params);
+
+// "model name" from /proc/cpuinfo, "unknown" where that isn't available.
+std::string cpu_model();
+
+// $S21_TUNING_CACHE, else s21_matrix/tuning under $XDG_CACHE_HOME or
+// ~/.cache.
+std::string tuning_cache_path();
+
+// The cache holds one line per CPU model. Loading returns false when the
+// file has no valid entry for the model.
+bool load_tuning(const std::string &path, const std::string &model,
+                 TuningParams &params);
+void save_tuning(const std::string &path, const std::string &model,
+                 const TuningParams &params);
+
+// Times candidate parameters on this machine and returns the fastest ones,
+// progress goes to log when it is set. Takes several seconds.
+TuningParams autotune(
+    const std::function<void(const std::string &)> &log = nullptr);
+
+}  // namespace s21
+
+#endif  // SRC_S21_TUNING_H_
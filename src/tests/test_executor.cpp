@@ -0,0 +1,215 @@
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../s21_matrix_oop.hpp"
+#include "../s21_parallel.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+S21Matrix diagonal(int32_t size, double value) {
+    S21Matrix m(size, size);
+    for (int32_t i = 0; i < size; ++i)
+        m[i][i] = value;
+    return m;
+}
+
+S21Matrix noise(int32_t rows, int32_t cols, uint32_t seed) {
+    S21Matrix m(rows, cols);
+    for (int32_t i = 0; i < rows; ++i)
+        for (int32_t j = 0; j < cols; ++j) {
+            seed = seed * 1664525u + 1013904223u;
+            m[i][j] = static_cast<double>(seed >> 8) / (1 << 24) - 0.5;
+        }
+    return m;
+}
+
+// Restores the default threading setup when a test ends.
+struct ThreadSettings {
+    ~ThreadSettings() {
+        s21::set_max_threads(0);
+        s21::set_reproducible(false);
+    }
+};
+
+}  // namespace
+
+TEST(test_async, operations) {
+    S21Matrix a = diagonal(3, 2);
+    S21Matrix b(3, 2);
+    b[1][1] = 3;
+
+    auto product = a.MulAsync(b);
+    auto inverse = a.InverseAsync();
+    auto det = a.DeterminantAsync();
+
+    a[0][0] = 100;
+
+    S21Matrix expected(3, 2);
+    expected[1][1] = 6;
+    ASSERT_TRUE(product.get() == expected);
+    ASSERT_TRUE(inverse.get() == diagonal(3, 0.5));
+    ASSERT_DOUBLE_EQ(det.get(), 8);
+}
+
+TEST(test_async, errors_are_forwarded) {
+    S21Matrix singular(2, 2);
+    auto inverse = singular.InverseAsync();
+    EXPECT_THROW(inverse.get(), std::logic_error);
+
+    EXPECT_THROW(singular.MulAsync(S21Matrix(3, 3)), std::logic_error);
+}
+
+TEST(test_async, cancelled_before_start) {
+    s21::CancelToken token;
+    token.Cancel();
+
+    auto det = diagonal(4, 1).DeterminantAsync(token);
+    EXPECT_THROW(det.get(), s21::OperationCancelled);
+}
+
+TEST(test_task_graph, dependencies) {
+    S21Matrix a = diagonal(4, 2), b = diagonal(4, 3);
+    S21Matrix ab, ba, sum;
+
+    s21::TaskGraph graph;
+    auto n1 = graph.Add([&] { ab = a * b; });
+    auto n2 = graph.Add([&] { ba = b * a; });
+    graph.Add([&] { sum = ab + ba; }, {n1, n2});
+    graph.Launch().get();
+
+    ASSERT_TRUE(sum == diagonal(4, 12));
+    EXPECT_ANY_THROW(graph.Add([] {}, {5}));
+}
+
+TEST(test_task_graph, ordering) {
+    std::vector<int> order;
+    std::mutex mutex;
+    auto record = [&](int id) {
+        return [&, id] {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(id);
+        };
+    };
+
+    s21::TaskGraph graph;
+    auto first = graph.Add(record(0));
+    auto second = graph.Add(record(1), {first});
+    graph.Add(record(2), {second});
+    graph.Launch().get();
+
+    ASSERT_EQ(order, (std::vector<int>{0, 1, 2}));
+}
+
+TEST(test_task_graph, failure_skips_dependents) {
+    bool ran = false;
+    s21::TaskGraph graph;
+    auto fail = graph.Add([] { throw std::logic_error("boom"); });
+    graph.Add([&] { ran = true; }, {fail});
+
+    EXPECT_THROW(graph.Launch().get(), std::logic_error);
+    EXPECT_FALSE(ran);
+}
+
+TEST(test_task_graph, cancellation) {
+    s21::CancelToken token;
+    bool ran = false;
+    s21::TaskGraph graph;
+    auto first = graph.Add([&] { token.Cancel(); });
+    graph.Add([&] { ran = true; }, {first});
+
+    EXPECT_THROW(graph.Launch(token).get(), s21::OperationCancelled);
+    EXPECT_FALSE(ran);
+}
+
+TEST(test_executor, nested_parallel_work) {
+    S21Matrix big(700, 700);
+    std::vector<std::future<bool>> results;
+    for (int i = 0; i < 8; ++i)
+        results.push_back(s21::Async([&big] { return big == big; }));
+
+    for (auto &result : results)
+        EXPECT_TRUE(result.get());
+}
+
+TEST(test_executor, parts_stay_with_their_worker) {
+    ThreadSettings restore;
+    s21::set_reproducible(true);
+    s21::set_max_threads(3);
+
+    const std::thread::id caller = std::this_thread::get_id();
+    std::vector<std::thread::id> expected;
+    for (int run = 0; run < 2; ++run) {
+        std::vector<std::thread::id> owner(12);
+        s21::parallel_for(1200, 100, [&](int64_t begin, int64_t) {
+            owner[begin / 100] = std::this_thread::get_id();
+            // Gives the workers time to take their own parts first.
+            if (owner[begin / 100] == caller)
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        });
+
+        EXPECT_EQ(owner[0], caller);
+        EXPECT_NE(owner[1], caller);
+        EXPECT_NE(owner[2], caller);
+        for (size_t part = 3; part < owner.size(); ++part)
+            EXPECT_EQ(owner[part], owner[part % 3]);
+        if (expected.empty())
+            expected = owner;
+        EXPECT_EQ(owner, expected);
+    }
+}
+
+TEST(test_reproducible, ranges_ignore_thread_count) {
+    ThreadSettings restore;
+    s21::set_reproducible(true);
+
+    std::vector<std::pair<int64_t, int64_t>> expected;
+    for (int32_t threads : {1, 2, 3, 8}) {
+        s21::set_max_threads(threads);
+        std::vector<std::pair<int64_t, int64_t>> ranges;
+        std::mutex mutex;
+        s21::parallel_for(1000, 64, [&](int64_t begin, int64_t end) {
+            std::lock_guard<std::mutex> lock(mutex);
+            ranges.emplace_back(begin, end);
+        });
+        std::sort(ranges.begin(), ranges.end());
+
+        ASSERT_EQ(ranges.size(), 1000u / 64);
+        if (expected.empty())
+            expected = ranges;
+        EXPECT_EQ(ranges, expected);
+    }
+    EXPECT_ANY_THROW(s21::set_max_threads(-1));
+}
+
+TEST(test_reproducible, bitwise_across_thread_counts) {
+    ThreadSettings restore;
+    s21::set_reproducible(true);
+
+    S21Matrix a = noise(300, 310, 1);
+    S21Matrix b = noise(310, 700, 2);
+    S21Matrix square = noise(120, 120, 3);
+    S21Matrix wide = noise(400, 2000, 4);
+
+    s21::set_max_threads(1);
+    const S21Matrix product = a * b;
+    const S21Matrix inverse = square.InverseMatrix();
+    const S21Matrix col_sums = wide.ColSums();
+    const double sum = wide.Sum();
+    const double norm = wide.Norm();
+
+    for (int32_t threads : {2, 3, 5}) {
+        s21::set_max_threads(threads);
+        EXPECT_TRUE((a * b).EqMatrix(product, S21Matrix::Compare::kBitwise));
+        EXPECT_TRUE(square.InverseMatrix().EqMatrix(
+            inverse, S21Matrix::Compare::kBitwise));
+        EXPECT_TRUE(
+            wide.ColSums().EqMatrix(col_sums, S21Matrix::Compare::kBitwise));
+        EXPECT_EQ(wide.Sum(), sum);
+        EXPECT_EQ(wide.Norm(), norm);
+    }
+}
@@ -0,0 +1,153 @@
+#include <cmath>
+
+#include "../s21_krylov.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+// 1D Poisson matrix, symmetric positive definite with condition ~ n^2.
+S21Matrix poisson(int32_t n) {
+    S21Matrix a(n, n);
+    for (int32_t i = 0; i < n; ++i) {
+        a[i][i] = 2.0;
+        if (i > 0)
+            a[i][i - 1] = -1.0;
+        if (i + 1 < n)
+            a[i][i + 1] = -1.0;
+    }
+    return a;
+}
+
+// Diagonally dominant, nonsymmetric convection-diffusion like operator.
+S21Matrix convection(int32_t n) {
+    S21Matrix a(n, n);
+    for (int32_t i = 0; i < n; ++i) {
+        a[i][i] = 4.0 + 0.01 * i;
+        if (i > 0)
+            a[i][i - 1] = -1.5;
+        if (i + 1 < n)
+            a[i][i + 1] = -0.5;
+        if (i + 7 < n)
+            a[i][i + 7] = 0.3;
+    }
+    return a;
+}
+
+S21Matrix rhs(int32_t n) {
+    S21Matrix b(n, 1);
+    for (int32_t i = 0; i < n; ++i)
+        b[i][0] = std::sin(0.1 * i) + 1.0;
+    return b;
+}
+
+double relative_residual(const S21Matrix &a, const S21Matrix &x,
+                         const S21Matrix &b) {
+    S21Matrix r = b - a * x;
+    double num = 0, den = 0;
+    for (int32_t i = 0; i < b.get_rows(); ++i) {
+        num += r[i][0] * r[i][0];
+        den += b[i][0] * b[i][0];
+    }
+    return std::sqrt(num / den);
+}
+
+}  // namespace
+
+TEST(test_krylov, cg) {
+    const int32_t n = 100;
+    S21Matrix a = poisson(n), b = rhs(n);
+    s21::KrylovSolver solver(s21::KrylovSolver::Method::kCg, n);
+
+    S21Matrix x(n, 1);
+    s21::SolverStats stats = solver.Solve(a, b, x);
+    EXPECT_TRUE(stats.converged);
+    EXPECT_LE(stats.iterations, n);
+    EXPECT_LT(relative_residual(a, x, b), 1e-9);
+
+    // The workspace is reused, a second solve from the answer is free.
+    stats = solver.Solve(a, b, x);
+    EXPECT_TRUE(stats.converged);
+    EXPECT_LE(stats.iterations, 1);
+
+    S21Matrix y(n, 1);
+    s21::JacobiPreconditioner jacobi(a);
+    EXPECT_TRUE(solver.Solve(a, b, y, &jacobi).converged);
+    EXPECT_LT(relative_residual(a, y, b), 1e-9);
+}
+
+TEST(test_krylov, gmres_and_bicgstab) {
+    const int32_t n = 120;
+    S21Matrix a = convection(n), b = rhs(n);
+    s21::Ilu0Preconditioner ilu(a);
+    s21::JacobiPreconditioner jacobi(a);
+
+    for (auto method : {s21::KrylovSolver::Method::kGmres,
+                        s21::KrylovSolver::Method::kBiCgStab}) {
+        s21::KrylovSolver solver(method, n, 20);
+        S21Matrix plain(n, 1), with_jacobi(n, 1), with_ilu(n, 1);
+
+        s21::SolverStats stats = solver.Solve(a, b, plain);
+        ASSERT_TRUE(stats.converged);
+        EXPECT_LT(relative_residual(a, plain, b), 1e-9);
+
+        ASSERT_TRUE(solver.Solve(a, b, with_jacobi, &jacobi).converged);
+        EXPECT_LT(relative_residual(a, with_jacobi, b), 1e-9);
+
+        s21::SolverStats ilu_stats = solver.Solve(a, b, with_ilu, &ilu);
+        ASSERT_TRUE(ilu_stats.converged);
+        EXPECT_LT(relative_residual(a, with_ilu, b), 1e-9);
+        EXPECT_LT(ilu_stats.iterations, stats.iterations);
+    }
+}
+
+TEST(test_krylov, ilu0_is_exact_for_tridiagonal) {
+    // No fill-in happens, so ILU(0) is the full LU and one step suffices.
+    const int32_t n = 50;
+    S21Matrix a = poisson(n), b = rhs(n);
+    s21::Ilu0Preconditioner ilu(a);
+    s21::KrylovSolver solver(s21::KrylovSolver::Method::kGmres, n);
+
+    S21Matrix x(n, 1);
+    s21::SolverStats stats = solver.Solve(a, b, x, &ilu);
+    EXPECT_TRUE(stats.converged);
+    EXPECT_EQ(stats.iterations, 1);
+}
+
+TEST(test_krylov, operator_callback) {
+    // Matrix-free Poisson operator.
+    const int32_t n = 200;
+    s21::LinearOperator op = [n](const double *in, double *out) {
+        for (int32_t i = 0; i < n; ++i)
+            out[i] = 2.0 * in[i] - (i > 0 ? in[i - 1] : 0.0) -
+                     (i + 1 < n ? in[i + 1] : 0.0);
+    };
+    S21Matrix b = rhs(n), x(n, 1);
+    s21::KrylovSolver solver(s21::KrylovSolver::Method::kCg, n);
+    solver.set_tolerance(1e-12);
+
+    EXPECT_TRUE(solver.Solve(op, b, x).converged);
+    EXPECT_LT(relative_residual(poisson(n), x, b), 1e-11);
+}
+
+TEST(test_krylov, limits_and_errors) {
+    const int32_t n = 100;
+    S21Matrix a = poisson(n), b = rhs(n), x(n, 1);
+    s21::KrylovSolver solver(s21::KrylovSolver::Method::kBiCgStab, n);
+    solver.set_max_iterations(3);
+
+    s21::SolverStats stats = solver.Solve(a, b, x);
+    EXPECT_FALSE(stats.converged);
+    EXPECT_EQ(stats.iterations, 3);
+    EXPECT_GT(stats.residual, solver.get_tolerance());
+
+    S21Matrix zero(n, 1);
+    stats = solver.Solve(a, zero, x);
+    EXPECT_TRUE(stats.converged);
+    EXPECT_EQ(x[n - 1][0], 0.0);
+
+    EXPECT_ANY_THROW(solver.Solve(S21Matrix(3, 3), b, x));
+    EXPECT_ANY_THROW(solver.Solve(a, S21Matrix(n, 2), x));
+    EXPECT_ANY_THROW(solver.set_tolerance(0));
+    EXPECT_ANY_THROW(s21::JacobiPreconditioner(S21Matrix(3, 3)));
+    EXPECT_ANY_THROW(s21::KrylovSolver(s21::KrylovSolver::Method::kGmres, n, 0));
+}
@@ -684,3 +684,688 @@ TEST(test_functional, brackets_const) {
 
     ASSERT_EQ(m(0, 0), 0);
 }
+
+TEST(test_decomposition, symmetric_eigen) {
+    const int32_t size = 4;
+    S21Matrix m(size, size);
+    for (int32_t i = 0; i < size; ++i)
+        for (int32_t j = 0; j <= i; ++j)
+            m[i][j] = m[j][i] = 1.0 / (i + j + 1) + (i == j ? 2 : 0);
+
+    S21Matrix values, vectors;
+    m.SymmetricEigen(values, vectors);
+
+    ASSERT_EQ(values.get_rows(), size);
+    for (int32_t i = 1; i < size; ++i)
+        EXPECT_LE(values[i - 1][0], values[i][0]);
+
+    for (int32_t i = 0; i < size; ++i) {
+        for (int32_t j = 0; j < size; ++j) {
+            double av = 0;
+            for (int32_t k = 0; k < size; ++k)
+                av += m[i][k] * vectors[k][j];
+            EXPECT_NEAR(av, values[j][0] * vectors[i][j], 1e-10);
+        }
+    }
+}
+
+TEST(test_decomposition, symmetric_eigen_throw) {
+    S21Matrix values, vectors;
+    S21Matrix rect(2, 3);
+    EXPECT_ANY_THROW(rect.SymmetricEigen(values, vectors));
+
+    S21Matrix m(2, 2);
+    m[0][1] = 1;
+    EXPECT_ANY_THROW(m.SymmetricEigen(values, vectors));
+
+    EXPECT_ANY_THROW(S21Matrix().SymmetricEigen(values, vectors));
+}
+
+static void check_eigen(const S21Matrix &m) {
+    S21Matrix values, vectors;
+    m.SymmetricEigen(values, vectors);
+
+    const int32_t size = m.get_rows();
+    ASSERT_EQ(values.get_rows(), size);
+    for (int32_t i = 1; i < size; ++i)
+        EXPECT_LE(values[i - 1][0], values[i][0]);
+
+    const S21Matrix av = m * vectors;
+    const S21Matrix vtv = vectors.Transpose() * vectors;
+    for (int32_t i = 0; i < size; ++i) {
+        for (int32_t j = 0; j < size; ++j) {
+            EXPECT_NEAR(av[i][j], values[j][0] * vectors[i][j], 1e-10);
+            EXPECT_NEAR(vtv[i][j], i == j ? 1 : 0, 1e-12);
+        }
+    }
+}
+
+TEST(test_decomposition, symmetric_eigen_blocked) {
+    const int32_t size = 150;
+    S21Matrix m(size, size);
+    for (int32_t i = 0; i < size; ++i)
+        for (int32_t j = 0; j <= i; ++j)
+            m[i][j] = m[j][i] = std::sin(0.7 * i * j + i + 2.0 * j);
+    check_eigen(m);
+}
+
+TEST(test_decomposition, symmetric_eigen_rounded_product) {
+    const int32_t size = 50;
+    S21Matrix a(size, size);
+    S21Matrix d(size, size);
+    for (int32_t i = 0; i < size; ++i) {
+        d[i][i] = 1e6 * (i + 1);
+        for (int32_t j = 0; j < size; ++j)
+            a[i][j] = 1e3 * std::sin(0.37 * i * j + i) + 0.1 * j;
+    }
+    const S21Matrix m = a * d * a.Transpose();
+    ASSERT_FALSE(m.EqMatrix(m.Transpose(), S21Matrix::Compare::kBitwise));
+
+    S21Matrix values, vectors;
+    ASSERT_NO_THROW(m.SymmetricEigen(values, vectors));
+    EXPECT_GT(values[0][0], 0);
+}
+
+TEST(test_decomposition, symmetric_eigen_repeated) {
+    const int32_t size = 120;
+    S21Matrix m(size, size);
+    for (int32_t i = 0; i < size; ++i)
+        for (int32_t j = 0; j < size; ++j)
+            m[i][j] = (i == j ? 2 : 0) + (i % 3 == 0 && j % 3 == 0 ? 1 : 0);
+    check_eigen(m);
+
+    S21Matrix values, vectors;
+    m.SymmetricEigen(values, vectors);
+    EXPECT_NEAR(values[size - 2][0], 2, 1e-12);
+    EXPECT_NEAR(values[size - 1][0], 42, 1e-12);
+}
+
+static void check_svd(const S21Matrix &m) {
+    S21Matrix u, sigma, v;
+    m.Svd(u, sigma, v);
+
+    const int32_t k = std::min(m.get_rows(), m.get_cols());
+    ASSERT_EQ(u.get_rows(), m.get_rows());
+    ASSERT_EQ(u.get_cols(), k);
+    ASSERT_EQ(v.get_rows(), m.get_cols());
+    ASSERT_EQ(v.get_cols(), k);
+    ASSERT_EQ(sigma.get_rows(), k);
+
+    for (int32_t i = 1; i < k; ++i)
+        EXPECT_GE(sigma[i - 1][0], sigma[i][0]);
+
+    for (int32_t i = 0; i < m.get_rows(); ++i) {
+        for (int32_t j = 0; j < m.get_cols(); ++j) {
+            double usv = 0;
+            for (int32_t l = 0; l < k; ++l)
+                usv += u[i][l] * sigma[l][0] * v[j][l];
+            EXPECT_NEAR(usv, m[i][j], 1e-10);
+        }
+    }
+}
+
+TEST(test_decomposition, svd_tall) {
+    S21Matrix m(5, 3);
+    for (int32_t i = 0, c = 1; i < 5; ++i)
+        for (int32_t j = 0; j < 3; ++j, ++c)
+            m[i][j] = (c * 7) % 11 - 5;
+    check_svd(m);
+}
+
+TEST(test_decomposition, svd_wide) {
+    S21Matrix m(2, 4);
+    for (int32_t i = 0, c = 1; i < 2; ++i)
+        for (int32_t j = 0; j < 4; ++j, ++c)
+            m[i][j] = c;
+    check_svd(m);
+}
+
+TEST(test_decomposition, svd_singular_values) {
+    S21Matrix m(3, 3);
+    m[0][0] = 3;
+    m[1][1] = -5;
+    m[2][2] = 1;
+
+    S21Matrix u, sigma, v;
+    m.Svd(u, sigma, v);
+    EXPECT_NEAR(sigma[0][0], 5, 1e-12);
+    EXPECT_NEAR(sigma[1][0], 3, 1e-12);
+    EXPECT_NEAR(sigma[2][0], 1, 1e-12);
+}
+
+TEST(test_decomposition, svd_blocked) {
+    S21Matrix m(130, 90);
+    for (int32_t i = 0; i < 130; ++i)
+        for (int32_t j = 0; j < 90; ++j)
+            m[i][j] = std::sin(0.3 * i * j + i - j);
+    check_svd(m);
+    check_svd(m.Transpose());
+}
+
+TEST(test_decomposition, svd_rank_deficient) {
+    S21Matrix m(80, 80);
+    for (int32_t i = 0; i < 80; ++i)
+        for (int32_t j = 0; j < 80; ++j)
+            m[i][j] = (i % 5) * (j % 7) + 1;
+    check_svd(m);
+}
+
+static S21Matrix filled(int32_t rows, int32_t cols, double start) {
+    S21Matrix m(rows, cols);
+    for (int32_t i = 0; i < rows; ++i)
+        for (int32_t j = 0; j < cols; ++j)
+            m[i][j] = start + i * cols + j;
+    return m;
+}
+
+static S21Matrix naive_mul(const S21Matrix &a, const S21Matrix &b) {
+    S21Matrix res(a.get_rows(), b.get_cols());
+    for (int32_t i = 0; i < a.get_rows(); ++i)
+        for (int32_t j = 0; j < b.get_cols(); ++j)
+            for (int32_t k = 0; k < a.get_cols(); ++k)
+                res[i][j] += a[i][k] * b[k][j];
+    return res;
+}
+
+TEST(test_gemm, accumulate) {
+    S21Matrix a = filled(3, 4, 1);
+    S21Matrix b = filled(4, 2, -3);
+    S21Matrix c = filled(3, 2, 0.5);
+
+    S21Matrix expected = naive_mul(a, b) * 2.0 + c * 3.0;
+    S21Matrix::Gemm(2.0, a, false, b, false, 3.0, c);
+
+    ASSERT_TRUE(c == expected);
+}
+
+TEST(test_gemm, transposed_operands) {
+    S21Matrix a = filled(4, 3, 1);
+    S21Matrix b = filled(2, 4, 2);
+    S21Matrix c(3, 2);
+
+    S21Matrix::Gemm(1.0, a, true, b, true, 0.0, c);
+
+    ASSERT_TRUE(c == naive_mul(a.Transpose(), b.Transpose()));
+}
+
+TEST(test_gemm, blocked) {
+    S21Matrix a = filled(130, 300, -100);
+    S21Matrix b = filled(300, 270, 1e-3);
+    S21Matrix c(130, 270);
+    for (int32_t i = 0; i < 130; ++i)
+        c[i][i] = 1e30;
+
+    S21Matrix::Gemm(1.0, a, false, b, false, 0.0, c);
+
+    ASSERT_TRUE(c == naive_mul(a, b));
+}
+
+TEST(test_gemm, throws) {
+    S21Matrix a = filled(3, 3, 1);
+    S21Matrix c(3, 2);
+
+    EXPECT_ANY_THROW(S21Matrix::Gemm(1.0, a, false, a, false, 0.0, c));
+    EXPECT_ANY_THROW(S21Matrix::Gemm(1.0, a, false, a, false, 0.0, a));
+}
+
+TEST(test_gemm, rectangular_product) {
+    S21Matrix a = filled(2, 3, 1);
+    S21Matrix b = filled(3, 4, -2);
+    S21Matrix expected = naive_mul(a, b);
+
+    ASSERT_TRUE(a * b == expected);
+
+    a.MulMatrix(b);
+    ASSERT_TRUE(a == expected);
+}
+
+TEST(test_gemm, matrix_vector) {
+    S21Matrix a = filled(1000, 10, -500);
+    S21Matrix x = filled(10, 1, 0.25);
+
+    S21Matrix y = a * x;
+    ASSERT_EQ(y.get_rows(), 1000);
+    ASSERT_EQ(y.get_cols(), 1);
+    ASSERT_TRUE(y == naive_mul(a, x));
+
+    S21Matrix row = filled(1, 1000, 3);
+    ASSERT_TRUE(row * a == naive_mul(row, a));
+}
+
+TEST(test_gemm, outer_product) {
+    S21Matrix x = filled(3, 1, 1);
+    S21Matrix y = filled(1, 4, -1);
+
+    ASSERT_TRUE(x * y == naive_mul(x, y));
+
+    S21Matrix a = filled(3, 4, 0);
+    S21Matrix expected = a + naive_mul(x, y) * 0.5;
+    S21Matrix::Ger(0.5, x, y, a);
+    ASSERT_TRUE(a == expected);
+}
+
+TEST(test_gemm, gemv_accumulate) {
+    S21Matrix a = filled(4, 3, 1);
+    S21Matrix x = filled(1, 4, 2);
+    S21Matrix y = filled(3, 1, 5);
+
+    S21Matrix expected = naive_mul(a.Transpose(), x.Transpose()) * 2.0 + y;
+    S21Matrix::Gemv(2.0, a, true, x, 1.0, y);
+    ASSERT_TRUE(y == expected);
+
+    EXPECT_ANY_THROW(S21Matrix::Gemv(1.0, a, false, x, 0.0, y));
+}
+
+TEST(test_compare, modes) {
+    S21Matrix a = filled(3, 3, 1e6);
+    S21Matrix b{a};
+    b[2][1] += 1e-3;
+
+    EXPECT_FALSE(a.EqMatrix(b));
+    EXPECT_TRUE(a.EqMatrix(b, S21Matrix::Compare::kAbsolute, 1e-2));
+    EXPECT_TRUE(a.EqMatrix(b, S21Matrix::Compare::kRelative, 1e-8));
+    EXPECT_FALSE(a.EqMatrix(b, S21Matrix::Compare::kRelative, 1e-10));
+    EXPECT_FALSE(a.EqMatrix(b, S21Matrix::Compare::kBitwise));
+    EXPECT_TRUE(a.EqMatrix(a, S21Matrix::Compare::kBitwise));
+}
+
+TEST(test_compare, ulp) {
+    S21Matrix a(1, 2);
+    S21Matrix b(1, 2);
+    a[0][0] = 1.0;
+    b[0][0] = std::nextafter(std::nextafter(1.0, 2.0), 2.0);
+    a[0][1] = 0.0;
+    b[0][1] = -0.0;
+
+    EXPECT_TRUE(a.EqMatrix(b, S21Matrix::Compare::kUlp, 2));
+    EXPECT_FALSE(a.EqMatrix(b, S21Matrix::Compare::kUlp, 1));
+    EXPECT_FALSE(a.EqMatrix(b, S21Matrix::Compare::kBitwise));
+}
+
+TEST(test_compare, nan_is_not_equal) {
+    S21Matrix a(2, 2);
+    S21Matrix b(2, 2);
+    a[1][1] = b[1][1] = std::nan("");
+
+    EXPECT_FALSE(a == b);
+    EXPECT_FALSE(a.EqMatrix(b, S21Matrix::Compare::kUlp, 1e9));
+}
+
+TEST(test_compare, infinity_is_equal) {
+    const double inf = std::numeric_limits<double>::infinity();
+    S21Matrix a(2, 2);
+    S21Matrix b(2, 2);
+    a[0][1] = b[0][1] = inf;
+    a[1][0] = b[1][0] = -inf;
+
+    EXPECT_TRUE(a == b);
+    EXPECT_TRUE(a.EqMatrix(b, S21Matrix::Compare::kRelative, 1e-12));
+    EXPECT_TRUE(a.EqMatrix(b, S21Matrix::Compare::kUlp, 0));
+    EXPECT_EQ(a.Diff(b).max_error, 0);
+    EXPECT_EQ(a.Diff(b, S21Matrix::Compare::kRelative).max_error, 0);
+
+    b[1][0] = inf;
+    EXPECT_FALSE(a == b);
+    EXPECT_EQ(a.Diff(b).max_error, inf);
+}
+
+TEST(test_compare, large_parallel) {
+    S21Matrix a = filled(1024, 1024, 0);
+    S21Matrix b{a};
+    ASSERT_TRUE(a == b);
+
+    b[1000][3] += 1;
+    ASSERT_FALSE(a == b);
+}
+
+TEST(test_compare, diff) {
+    S21Matrix a = filled(600, 600, 0);
+    S21Matrix b{a};
+    b[10][20] += 0.5;
+    b[599][1] -= 2;
+    b[300][300] += 2;
+
+    S21Matrix::DiffResult d = a.Diff(b);
+    EXPECT_DOUBLE_EQ(d.max_error, 2);
+    EXPECT_EQ(d.row, 300);
+    EXPECT_EQ(d.col, 300);
+
+    d = a.Diff(a);
+    EXPECT_EQ(d.max_error, 0);
+
+    EXPECT_ANY_THROW(a.Diff(S21Matrix(2, 2)));
+}
+
+static double naive_det(const S21Matrix &m) {
+    const int32_t n = m.get_rows();
+    if (n == 1)
+        return m[0][0];
+
+    double res = 0;
+    for (int32_t skip = 0; skip < n; ++skip) {
+        S21Matrix minor(n - 1, n - 1);
+        for (int32_t i = 1; i < n; ++i)
+            for (int32_t j = 0, c = 0; j < n; ++j)
+                if (j != skip)
+                    minor[i - 1][c++] = m[i][j];
+        res += (skip % 2 ? -1 : 1) * m[0][skip] * naive_det(minor);
+    }
+    return res;
+}
+
+static S21Matrix naive_complements(const S21Matrix &m) {
+    const int32_t n = m.get_rows();
+    S21Matrix res(n, n);
+    for (int32_t r = 0; r < n; ++r) {
+        for (int32_t c = 0; c < n; ++c) {
+            S21Matrix minor(n - 1, n - 1);
+            for (int32_t i = 0, mi = 0; i < n; ++i) {
+                if (i == r)
+                    continue;
+                for (int32_t j = 0, mj = 0; j < n; ++j)
+                    if (j != c)
+                        minor[mi][mj++] = m[i][j];
+                ++mi;
+            }
+            res[r][c] = ((r + c) % 2 ? -1 : 1) * naive_det(minor);
+        }
+    }
+    return res;
+}
+
+TEST(test_functional, complements_nonsingular) {
+    S21Matrix m(6, 6);
+    for (int32_t i = 0; i < 6; ++i)
+        for (int32_t j = 0; j < 6; ++j)
+            m[i][j] = ((i * 5 + j * 3) % 7) - 3 + (i == j ? 4 : 0);
+
+    ASSERT_TRUE(m.CalcComplements() == naive_complements(m));
+}
+
+TEST(test_functional, complements_singular) {
+    S21Matrix m(4, 4);
+    for (int32_t i = 0; i < 4; ++i)
+        for (int32_t j = 0; j < 4; ++j)
+            m[i][j] = (i == 3) ? (j + 1) * 2.0 : (i * 3 + j * j) % 5 + 1.0;
+    for (int32_t j = 0; j < 4; ++j)
+        m[3][j] = m[0][j] + m[1][j];
+
+    S21Matrix expected = naive_complements(m);
+    ASSERT_TRUE(m.CalcComplements() == expected);
+
+    S21Matrix rank_two(4, 4);
+    for (int32_t i = 0; i < 4; ++i)
+        for (int32_t j = 0; j < 4; ++j)
+            rank_two[i][j] = i + j;
+    ASSERT_TRUE(rank_two.CalcComplements() == S21Matrix(4, 4));
+}
+
+TEST(test_functional, determinant_large) {
+    const int32_t size = 200;
+    S21Matrix m(size, size);
+    double expected = 1;
+    for (int32_t i = 0; i < size; ++i) {
+        m[i][i] = 1 + 1.0 / (i + 1);
+        expected *= m[i][i];
+        for (int32_t j = i + 1; j < size; ++j)
+            m[i][j] = 0.5;
+    }
+    m = m.Transpose() * m;
+    expected *= expected;
+
+    ASSERT_NEAR(m.Determinant() / expected, 1, 1e-9);
+
+    S21Matrix identity(size, size);
+    for (int32_t i = 0; i < size; ++i)
+        identity[i][i] = 1;
+    ASSERT_TRUE((m * m.InverseMatrix())
+                    .EqMatrix(identity, S21Matrix::Compare::kAbsolute, 1e-6));
+}
+
+TEST(test_class, uninit_constructor) {
+    S21Matrix m(4, 5, S21Matrix::uninit);
+    EXPECT_EQ(m.get_rows(), 4);
+    EXPECT_EQ(m.get_cols(), 5);
+    EXPECT_ANY_THROW(S21Matrix(0, 5, S21Matrix::uninit));
+}
+
+TEST(test_gemm, zero_beta_ignores_previous_contents) {
+    S21Matrix a = filled(5, 3, 1);
+    S21Matrix b = filled(3, 4, 2);
+    S21Matrix c(5, 4, S21Matrix::uninit);
+    for (int32_t i = 0; i < 5; ++i)
+        for (int32_t j = 0; j < 4; ++j)
+            c[i][j] = std::nan("");
+
+    S21Matrix::Gemm(1.0, a, false, b, false, 0.0, c);
+    ASSERT_TRUE(c == naive_mul(a, b));
+
+    S21Matrix y(5, 1, S21Matrix::uninit);
+    y[2][0] = std::nan("");
+    S21Matrix x = filled(3, 1, 1);
+    S21Matrix::Gemv(1.0, a, false, x, 0.0, y);
+    ASSERT_TRUE(y == naive_mul(a, x));
+}
+
+TEST(test_functional, transpose_blocked) {
+    S21Matrix m = filled(70, 45, -3);
+    S21Matrix t = m.Transpose();
+    for (int32_t i = 0; i < 70; ++i)
+        for (int32_t j = 0; j < 45; ++j)
+            ASSERT_EQ(t[j][i], m[i][j]);
+}
+
+TEST(test_elementwise, hadamard) {
+    S21Matrix a = filled(3, 4, 1);
+    S21Matrix b = filled(3, 4, -2);
+    S21Matrix expected(3, 4);
+    for (int32_t i = 0; i < 3; ++i)
+        for (int32_t j = 0; j < 4; ++j)
+            expected[i][j] = a[i][j] * b[i][j];
+
+    a.Hadamard(b);
+    ASSERT_TRUE(a == expected);
+    EXPECT_ANY_THROW(a.Hadamard(S21Matrix(4, 3)));
+}
+
+TEST(test_elementwise, broadcast) {
+    S21Matrix m = filled(3, 2, 0);
+    S21Matrix row = filled(1, 2, 10);
+    S21Matrix col = filled(3, 1, 2);
+
+    m.BroadcastAdd(row);
+    EXPECT_EQ(m[2][1], 5 + 11);
+    m.BroadcastMul(col);
+    EXPECT_EQ(m[2][1], (5 + 11) * 4);
+    EXPECT_EQ(m[0][0], 10 * 2);
+
+    EXPECT_ANY_THROW(m.BroadcastAdd(S21Matrix(1, 3)));
+    EXPECT_ANY_THROW(m.BroadcastMul(S21Matrix(2, 1)));
+}
+
+TEST(test_elementwise, kronecker) {
+    S21Matrix a = filled(2, 3, 1);
+    S21Matrix b = filled(4, 2, -1);
+
+    S21Matrix k = a.Kronecker(b);
+    ASSERT_EQ(k.get_rows(), 8);
+    ASSERT_EQ(k.get_cols(), 6);
+    for (int32_t i = 0; i < 2; ++i)
+        for (int32_t j = 0; j < 3; ++j)
+            for (int32_t p = 0; p < 4; ++p)
+                for (int32_t q = 0; q < 2; ++q)
+                    ASSERT_EQ(k[i * 4 + p][j * 2 + q], a[i][j] * b[p][q]);
+}
+
+TEST(test_reduction, sums) {
+    S21Matrix m = filled(3, 4, 1);
+    EXPECT_EQ(m.Sum(), 78);
+
+    S21Matrix rows = m.RowSums();
+    ASSERT_EQ(rows.get_rows(), 3);
+    ASSERT_EQ(rows.get_cols(), 1);
+    EXPECT_EQ(rows[0][0], 1 + 2 + 3 + 4);
+    EXPECT_EQ(rows[2][0], 9 + 10 + 11 + 12);
+
+    S21Matrix cols = m.ColSums();
+    ASSERT_EQ(cols.get_rows(), 1);
+    ASSERT_EQ(cols.get_cols(), 4);
+    EXPECT_EQ(cols[0][0], 1 + 5 + 9);
+    EXPECT_EQ(cols[0][3], 4 + 8 + 12);
+}
+
+TEST(test_reduction, large_sums_are_accurate) {
+    const int32_t rows = 300, cols = 1000;
+    S21Matrix m(rows, cols);
+    for (int32_t i = 0; i < rows; ++i)
+        for (int32_t j = 0; j < cols; ++j)
+            m[i][j] = 0.1;
+
+    EXPECT_NEAR(m.Sum(), 0.1 * rows * cols, 1e-8);
+    S21Matrix cols_sum = m.ColSums();
+    for (int32_t j = 0; j < cols; ++j)
+        ASSERT_NEAR(cols_sum[0][j], 0.1 * rows, 1e-12);
+    S21Matrix rows_sum = m.RowSums();
+    for (int32_t i = 0; i < rows; ++i)
+        ASSERT_NEAR(rows_sum[i][0], 0.1 * cols, 1e-12);
+}
+
+TEST(test_reduction, col_sums_grouped_blocks) {
+    // One row per block and more blocks than are kept at once, the last
+    // group of blocks is short.
+    const int32_t rows = 700, cols = 2100;
+    S21Matrix m(rows, cols);
+    for (int32_t i = 0; i < rows; ++i)
+        for (int32_t j = 0; j < cols; ++j)
+            m[i][j] = (i * 31 + j * 17) % 13 - 6;
+
+    const S21Matrix sums = m.ColSums();
+    const double one = m.Norm(S21Matrix::NormType::kOne);
+    double expected_one = 0;
+    for (int32_t j = 0; j < cols; ++j) {
+        double sum = 0, abs = 0;
+        for (int32_t i = 0; i < rows; ++i) {
+            sum += m[i][j];
+            abs += std::fabs(m[i][j]);
+        }
+        ASSERT_EQ(sums[0][j], sum);
+        expected_one = std::max(expected_one, abs);
+    }
+    EXPECT_EQ(one, expected_one);
+}
+
+TEST(test_reduction, wide_row_norm) {
+    const int32_t cols = 10000;
+    S21Matrix m(2, cols);
+    S21Matrix abs(2, cols);
+    for (int32_t i = 0; i < 2; ++i) {
+        for (int32_t j = 0; j < cols; ++j) {
+            abs[i][j] = 0.1 * (i + 1) + 1e-3 * (j % 4);
+            m[i][j] = j % 2 ? -abs[i][j] : abs[i][j];
+        }
+    }
+
+    // The absolute row sums use the same pairwise tree as RowSums.
+    EXPECT_EQ(m.Norm(S21Matrix::NormType::kInf), abs.RowSums()[1][0]);
+    EXPECT_NEAR(m.Norm(S21Matrix::NormType::kInf), 0.2 * cols + 1.5e-3 * cols,
+                1e-8);
+}
+
+TEST(test_reduction, trace_and_norms) {
+    S21Matrix m = filled(3, 3, -4);
+    EXPECT_EQ(m.Trace(), -4 + 0 + 4);
+    EXPECT_ANY_THROW(filled(2, 3, 0).Trace());
+
+    // -4 -3 -2
+    // -1  0  1
+    //  2  3  4
+    EXPECT_EQ(m.Norm(S21Matrix::NormType::kMax), 4);
+    EXPECT_EQ(m.Norm(S21Matrix::NormType::kOne), 7);
+    EXPECT_EQ(m.Norm(S21Matrix::NormType::kInf), 9);
+    EXPECT_NEAR(m.Norm(), std::sqrt(60.0), 1e-12);
+
+    S21Matrix huge(1, 2);
+    huge[0][0] = 1e200;
+    huge[0][1] = 1e200;
+    EXPECT_NEAR(huge.Norm() / 1e200, std::sqrt(2.0), 1e-12);
+}
+
+TEST(test_reduction, min_max) {
+    S21Matrix m = filled(4, 5, -7);
+    m[1][2] = 100;
+    m[3][4] = 100;
+    m[0][1] = NAN;
+
+    auto [lo, hi] = m.MinMax();
+    EXPECT_EQ(lo, -7);
+    EXPECT_EQ(hi, 100);
+    auto [row, col] = m.ArgMax();
+    EXPECT_EQ(row, 1);
+    EXPECT_EQ(col, 2);
+    EXPECT_ANY_THROW(S21Matrix().MinMax());
+}
+
+TEST(test_functions, power) {
+    S21Matrix m = filled(4, 4, -1);
+    m.MulNumber(0.25);
+    for (int32_t i = 0; i < 4; ++i)
+        m[i][i] += 2;
+
+    S21Matrix expected = m;
+    for (int32_t k = 2; k <= 11; ++k) {
+        expected *= m;
+        ASSERT_TRUE(m.Power(k).EqMatrix(expected, S21Matrix::Compare::kRelative,
+                                        1e-10));
+    }
+    EXPECT_TRUE(m.Power(1) == m);
+
+    S21Matrix identity(4, 4);
+    for (int32_t i = 0; i < 4; ++i)
+        identity[i][i] = 1;
+    EXPECT_TRUE(m.Power(0) == identity);
+
+    S21Matrix inverse = m.InverseMatrix();
+    EXPECT_TRUE(m.Power(-3).EqMatrix(inverse * inverse * inverse,
+                                     S21Matrix::Compare::kRelative, 1e-10));
+    EXPECT_ANY_THROW(filled(2, 3, 0).Power(2));
+}
+
+TEST(test_functions, expm) {
+    S21Matrix diagonal(3, 3);
+    diagonal[0][0] = 1e-3;
+    diagonal[1][1] = -2;
+    diagonal[2][2] = 7;
+    S21Matrix exp = diagonal.Expm();
+    for (int32_t i = 0; i < 3; ++i)
+        for (int32_t j = 0; j < 3; ++j)
+            EXPECT_NEAR(exp[i][j], i == j ? std::exp(diagonal[i][i]) : 0.0,
+                        1e-13 * std::exp(7.0));
+
+    S21Matrix nilpotent(2, 2);
+    nilpotent[0][1] = 1;
+    exp = nilpotent.Expm();
+    EXPECT_EQ(exp[0][0], 1);
+    EXPECT_EQ(exp[0][1], 1);
+    EXPECT_EQ(exp[1][0], 0);
+    EXPECT_EQ(exp[1][1], 1);
+
+    // A rotation generator, large enough to need scaling.
+    const double t = 10;
+    S21Matrix rotation(2, 2);
+    rotation[0][1] = -t;
+    rotation[1][0] = t;
+    exp = rotation.Expm();
+    EXPECT_NEAR(exp[0][0], std::cos(t), 1e-12);
+    EXPECT_NEAR(exp[0][1], -std::sin(t), 1e-12);
+    EXPECT_NEAR(exp[1][0], std::sin(t), 1e-12);
+    EXPECT_NEAR(exp[1][1], std::cos(t), 1e-12);
+
+    S21Matrix m = filled(5, 5, -12);
+    m.MulNumber(0.1);
+    S21Matrix identity(5, 5);
+    for (int32_t i = 0; i < 5; ++i)
+        identity[i][i] = 1;
+    EXPECT_TRUE((m.Expm() * (m * -1.0).Expm())
+                    .EqMatrix(identity, S21Matrix::Compare::kAbsolute, 1e-9));
+    EXPECT_ANY_THROW(filled(2, 3, 0).Expm());
+}
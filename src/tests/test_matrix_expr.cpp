@@ -0,0 +1,89 @@
+#include "../s21_matrix_expr.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+S21Matrix make(int32_t rows, int32_t cols, double seed) {
+    S21Matrix m(rows, cols);
+    for (int32_t i = 0; i < rows; ++i)
+        for (int32_t j = 0; j < cols; ++j)
+            m[i][j] = ((i * 13 + j * 7 + static_cast<int32_t>(seed)) % 9) - 4;
+    return m;
+}
+
+}  // namespace
+
+TEST(test_expr, double_transpose) {
+    S21Matrix a = make(3, 4, 1);
+    S21Matrix b = make(4, 2, 2);
+
+    S21Matrix res = (a.Lazy().Transpose().Transpose() * b.Lazy()).Eval();
+    ASSERT_TRUE(res == a * b);
+}
+
+TEST(test_expr, transposed_product) {
+    S21Matrix a = make(3, 4, 1);
+    S21Matrix b = make(4, 5, 2);
+
+    S21Matrix res = (a.Lazy() * b.Lazy()).Transpose().Eval();
+    ASSERT_TRUE(res == (a * b).Transpose());
+}
+
+TEST(test_expr, chain_and_scale) {
+    S21Matrix a = make(300, 2, 1);
+    S21Matrix b = make(2, 300, 2);
+    S21Matrix x = make(300, 1, 3);
+
+    S21Matrix res = (2.0 * a.Lazy() * (b.Lazy() * 0.5) * x.Lazy()).Eval();
+    ASSERT_TRUE(res == a * (b * x));
+}
+
+TEST(test_expr, sums) {
+    S21Matrix a = make(4, 4, 1);
+    S21Matrix b = make(4, 4, 2);
+    S21Matrix c = make(4, 4, 3);
+
+    S21Matrix res = (a.Lazy() * b.Lazy() - c.Lazy().Transpose() +
+                     (a.Lazy() + b.Lazy()).Transpose() * c.Lazy())
+                        .Eval();
+    ASSERT_TRUE(res == a * b - c.Transpose() + (a + b).Transpose() * c);
+
+    S21Matrix t = (a.Lazy() + b.Lazy() * 3.0).Transpose().Eval();
+    ASSERT_TRUE(t == (a + b * 3.0).Transpose());
+}
+
+TEST(test_expr, owned_leaf) {
+    S21Matrix a = make(2, 3, 1);
+    s21::Expr e = a.Lazy() * make(3, 2, 5).Lazy();
+
+    ASSERT_EQ(e.get_rows(), 2);
+    ASSERT_EQ(e.get_cols(), 2);
+    ASSERT_TRUE(e.Eval() == a * make(3, 2, 5));
+}
+
+TEST(test_expr, throws) {
+    S21Matrix a = make(2, 3, 1);
+    EXPECT_ANY_THROW(a.Lazy() * a.Lazy());
+    EXPECT_ANY_THROW(a.Lazy() + a.Lazy().Transpose());
+}
+
+TEST(test_expr, lazy_kronecker) {
+    S21Matrix a = make(3, 4, 1);
+    S21Matrix b = make(2, 5, 2);
+    S21Matrix x = make(20, 1, 3);
+    S21Matrix xs = make(20, 3, 4);
+    S21Matrix dense = a.Kronecker(b);
+
+    s21::Expr kron = s21::Kronecker(a.Lazy(), b.Lazy());
+    ASSERT_EQ(kron.get_rows(), 6);
+    ASSERT_EQ(kron.get_cols(), 20);
+
+    ASSERT_TRUE((kron * x.Lazy()).Eval() == dense * x);
+    ASSERT_TRUE((2.0 * kron * xs.Lazy()).Eval() == dense * xs * 2.0);
+    ASSERT_TRUE((kron * xs.Lazy()).Transpose().Eval() ==
+                (dense * xs).Transpose());
+    ASSERT_TRUE(kron.Eval() == dense);
+    ASSERT_TRUE(kron.Transpose().Eval() == dense.Transpose());
+    ASSERT_TRUE(s21::Kronecker(a.Lazy().Transpose(), b.Lazy()).Eval() ==
+                a.Transpose().Kronecker(b));
+}
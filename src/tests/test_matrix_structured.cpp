@@ -0,0 +1,116 @@
+#include "../s21_matrix_structured.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+S21Matrix lower_dense(int32_t size) {
+    S21Matrix m(size, size);
+    for (int32_t i = 0; i < size; ++i)
+        for (int32_t j = 0; j <= i; ++j)
+            m[i][j] = (i == j) ? size + i : 1.0 / (i + 2 * j + 1);
+    return m;
+}
+
+S21Matrix rhs(int32_t rows, int32_t cols) {
+    S21Matrix m(rows, cols);
+    for (int32_t i = 0; i < rows; ++i)
+        for (int32_t j = 0; j < cols; ++j)
+            m[i][j] = (i * 7 + j * 3) % 5 - 2.0;
+    return m;
+}
+
+}  // namespace
+
+TEST(test_triangular, packed_access) {
+    S21TriangularMatrix l(3);
+    l(2, 1) = 5;
+    EXPECT_EQ(l(2, 1), 5);
+    EXPECT_ANY_THROW(l(1, 2) = 1);
+    EXPECT_EQ(static_cast<const S21TriangularMatrix &>(l)(1, 2), 0);
+
+    S21TriangularMatrix u(lower_dense(4).Transpose(),
+                          S21TriangularMatrix::Uplo::kUpper);
+    ASSERT_TRUE(u.ToDense() == lower_dense(4).Transpose());
+}
+
+TEST(test_triangular, solve) {
+    const int32_t size = 150;
+    S21Matrix dense = lower_dense(size);
+    S21Matrix b = rhs(size, 7);
+    S21TriangularMatrix l(dense);
+
+    ASSERT_TRUE(dense * l.Solve(b) == b);
+    ASSERT_TRUE(dense.Transpose() * l.Solve(b, true) == b);
+
+    S21TriangularMatrix u(dense.Transpose(), S21TriangularMatrix::Uplo::kUpper);
+    ASSERT_TRUE(dense.Transpose() * u.Solve(b) == b);
+    ASSERT_TRUE(dense * u.Solve(b, true) == b);
+}
+
+TEST(test_triangular, multiply) {
+    const int32_t size = 130;
+    S21Matrix dense = lower_dense(size);
+    S21Matrix b = rhs(size, 5);
+    S21TriangularMatrix l(dense);
+    S21TriangularMatrix u(dense.Transpose(), S21TriangularMatrix::Uplo::kUpper);
+
+    ASSERT_TRUE(l * b == dense * b);
+    ASSERT_TRUE(l.Multiply(b, true) == dense.Transpose() * b);
+    ASSERT_TRUE(u * b == dense.Transpose() * b);
+    ASSERT_TRUE(u.Multiply(b, true) == dense * b);
+}
+
+TEST(test_triangular, throws) {
+    S21TriangularMatrix l(3);
+    EXPECT_ANY_THROW(l.Solve(rhs(3, 1)));
+    EXPECT_ANY_THROW(l.Solve(rhs(2, 1)));
+    EXPECT_ANY_THROW(S21TriangularMatrix(S21Matrix(2, 3)));
+}
+
+TEST(test_symmetric, from_dense) {
+    S21Matrix dense = lower_dense(5);
+    S21Matrix sym = dense + dense.Transpose();
+    S21SymmetricMatrix s(sym);
+
+    EXPECT_EQ(s(1, 3), s(3, 1));
+    ASSERT_TRUE(s.ToDense() == sym);
+    EXPECT_ANY_THROW(S21SymmetricMatrix{dense});
+}
+
+TEST(test_symmetric, from_rounded_product) {
+    const int32_t size = 50;
+    S21Matrix a(size, size);
+    S21Matrix d(size, size);
+    for (int32_t i = 0; i < size; ++i) {
+        d[i][i] = 1e6 * (i + 1);
+        for (int32_t j = 0; j < size; ++j)
+            a[i][j] = 1e3 * std::sin(0.37 * i * j + i) + 0.1 * j;
+    }
+    S21Matrix sym = a * d * a.Transpose();
+    ASSERT_FALSE(sym.EqMatrix(sym.Transpose(), S21Matrix::Compare::kBitwise));
+
+    S21SymmetricMatrix s(sym);
+    EXPECT_EQ(s(3, 7), sym[7][3]);
+}
+
+TEST(test_symmetric, multiply) {
+    S21Matrix dense = lower_dense(100);
+    S21Matrix sym = dense + dense.Transpose();
+    S21Matrix b = rhs(100, 3);
+
+    ASSERT_TRUE(S21SymmetricMatrix(sym) * b == sym * b);
+}
+
+TEST(test_symmetric, syrk) {
+    S21Matrix a = rhs(90, 40);
+    S21SymmetricMatrix c(90);
+    c.Syrk(1.0, a, false, 0.0);
+    ASSERT_TRUE(c.ToDense() == a * a.Transpose());
+
+    S21SymmetricMatrix g(40);
+    g.Syrk(2.0, a, true, 0.0);
+    g.Syrk(1.0, a, true, 0.5);
+    ASSERT_TRUE(g.ToDense() == a.Transpose() * a * 2.0);
+
+    EXPECT_ANY_THROW(g.Syrk(1.0, a, false, 0.0));
+}
@@ -0,0 +1,38 @@
+#include "../s21_matrix_oop.hpp"
+#include "../s21_numa.hpp"
+#include "gtest/gtest.h"
+
+TEST(test_numa, topology) {
+    EXPECT_GE(s21::numa_node_count(), 1);
+}
+
+TEST(test_numa, large_buffers_are_zeroed) {
+    const s21::NumaPolicy saved = s21::get_numa_policy();
+    for (auto policy :
+         {s21::NumaPolicy::kFirstTouch, s21::NumaPolicy::kInterleave}) {
+        s21::set_numa_policy(policy);
+        EXPECT_EQ(s21::get_numa_policy(), policy);
+
+        S21Matrix m(1024, 512);
+        for (int32_t i = 0; i < 1024; i += 97)
+            for (int32_t j = 0; j < 512; j += 31)
+                ASSERT_EQ(m[i][j], 0);
+
+        m[1023][511] = 2;
+        S21Matrix copy(m);
+        S21Matrix assigned;
+        assigned = copy;
+        ASSERT_TRUE(assigned == m);
+        ASSERT_EQ(assigned[1023][511], 2);
+    }
+    s21::set_numa_policy(saved);
+}
+
+TEST(test_numa, resize_across_threshold) {
+    S21Matrix m(2, 2);
+    m[1][1] = 3;
+    m.set_rows(s21::kLargeAllocation);
+    EXPECT_EQ(m[1][1], 3);
+    m.set_rows(2);
+    EXPECT_EQ(m[1][1], 3);
+}
@@ -1,9 +1,11 @@
 #include "gtest/gtest.h"
 
-int main() {
-    testing::InitGoogleTest();
-    if (RUN_ALL_TESTS()) {
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    int res = RUN_ALL_TESTS();
+    if (res) {
         std::cout << "Some tests have failed :(\n"
                   << "Get back to work!" << std::endl;
     }
+    return res;
 }
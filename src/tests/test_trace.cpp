@@ -0,0 +1,57 @@
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "../s21_matrix_oop.hpp"
+#include "../s21_trace.hpp"
+#include "gtest/gtest.h"
+
+TEST(test_trace, json) {
+    s21::trace::clear();
+    S21Matrix a(40, 30), b(30, 20);
+    a[0][0] = 1;
+    std::thread([&] { a.Transpose(); }).join();
+    S21Matrix c = a * b;
+
+    std::ostringstream out;
+    s21::trace::write_json(out);
+    const std::string json = out.str();
+    EXPECT_EQ(json.rfind("{\"traceEvents\":[", 0), 0u);
+    EXPECT_NE(json.find("\"displayTimeUnit\":\"ns\"}"), std::string::npos);
+
+#ifdef S21_TRACING
+    EXPECT_NE(json.find("\"name\":\"operator*\""), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"gemm.pack\""), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"gemm.compute\""), std::string::npos);
+    EXPECT_NE(json.find("\"args\":{\"rows\":40,\"cols\":30}"),
+              std::string::npos);
+    // The span of the finished thread is kept, under its own tid.
+    EXPECT_NE(json.find("\"name\":\"Transpose\""), std::string::npos);
+    EXPECT_NE(json.find("\"tid\":2"), std::string::npos);
+
+    s21::trace::clear();
+    out.str("");
+    s21::trace::write_json(out);
+    EXPECT_EQ(out.str().find("\"name\""), std::string::npos);
+#else
+    EXPECT_EQ(json.find("\"name\""), std::string::npos);
+#endif
+}
+
+TEST(test_trace, short_comparison_has_no_span) {
+    S21Matrix a(100, 100), b(100, 100);
+    b[0][0] = 1;
+
+    s21::trace::clear();
+    EXPECT_FALSE(a == b);
+    std::ostringstream out;
+    s21::trace::write_json(out);
+    EXPECT_EQ(out.str().find("\"name\":\"EqMatrix\""), std::string::npos);
+
+#ifdef S21_TRACING
+    EXPECT_TRUE(a == a);
+    out.str("");
+    s21::trace::write_json(out);
+    EXPECT_NE(out.str().find("\"name\":\"EqMatrix\""), std::string::npos);
+#endif
+}
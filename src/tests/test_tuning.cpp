@@ -0,0 +1,64 @@
+#include <cstdio>
+#include <fstream>
+
+#include "../s21_matrix_oop.hpp"
+#include "../s21_parallel.hpp"
+#include "../s21_tuning.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+S21Matrix sequence(int32_t rows, int32_t cols) {
+    S21Matrix m(rows, cols);
+    for (int32_t i = 0; i < rows; ++i)
+        for (int32_t j = 0; j < cols; ++j)
+            m[i][j] = (i * 7 + j * 3) % 11 - 5;
+    return m;
+}
+
+}  // namespace
+
+TEST(test_tuning, cache_round_trip) {
+    const std::string path = testing::TempDir() + "s21_tuning_test";
+    std::remove(path.c_str());
+
+    s21::TuningParams params;
+    EXPECT_FALSE(s21::load_tuning(path, "cpu a", params));
+
+    s21::TuningParams a{32, 64, 512, 16, 1 << 16};
+    s21::TuningParams b{128, 256, 128, 64, 1 << 20};
+    s21::save_tuning(path, "cpu a", a);
+    s21::save_tuning(path, "cpu b", b);
+    a.gemm_block_m = 96;
+    s21::save_tuning(path, "cpu a", a);
+
+    ASSERT_TRUE(s21::load_tuning(path, "cpu a", params));
+    EXPECT_EQ(params.gemm_block_m, 96);
+    EXPECT_EQ(params.parallel_cutoff, 1 << 16);
+    ASSERT_TRUE(s21::load_tuning(path, "cpu b", params));
+    EXPECT_EQ(params.gemm_block_k, 256);
+    EXPECT_FALSE(s21::load_tuning(path, "cpu", params));
+
+    std::ofstream(path, std::ios::app) << "cpu c\t1 2 0 4 5\n";
+    EXPECT_FALSE(s21::load_tuning(path, "cpu c", params));
+    std::remove(path.c_str());
+}
+
+TEST(test_tuning, results_ignore_block_sizes) {
+    const S21Matrix a = sequence(70, 45), b = sequence(45, 90);
+    const S21Matrix product = a * b;
+    const S21Matrix transposed = a.Transpose();
+    const s21::TuningParams saved = s21::tuning();
+
+    s21::set_tuning({5, 7, 3, 3, 1 << 10});
+    EXPECT_EQ(s21::parallel_cutoff(), 1 << 10);
+    EXPECT_TRUE((a * b).EqMatrix(product, S21Matrix::Compare::kBitwise));
+    EXPECT_TRUE(a.Transpose() == transposed);
+
+    s21::set_reproducible(true);
+    EXPECT_EQ(s21::tuning().gemm_block_m, s21::TuningParams().gemm_block_m);
+    s21::set_reproducible(false);
+
+    s21::set_tuning(saved);
+    EXPECT_ANY_THROW(s21::set_tuning({0, 1, 1, 1, 1}));
+}
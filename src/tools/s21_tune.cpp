@@ -0,0 +1,23 @@
+#include <iostream>
+
+#include "../s21_tuning.hpp"
+
+// Benchmarks the kernel parameters on this machine and stores them in the
+// tuning cache, or in the file given as the first argument.
+int main(int argc, char **argv) {
+    const std::string path = argc > 1 ? argv[1] : s21::tuning_cache_path();
+    const std::string model = s21::cpu_model();
+    std::cout << "Tuning for " << model << std::endl;
+
+    s21::TuningParams params = s21::autotune(
+        [](const std::string &message) { std::cout << message << std::endl; });
+
+    try {
+        s21::save_tuning(path, model, params);
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    std::cout << "Saved to " << path << std::endl;
+    return 0;
+}